@@ -18,8 +18,10 @@
 #include <string.h>
 #include <cmath>
 #include <assert.h>
+#include <algorithm>
 
 #include "StringUtils.h"
+#include <sstream>
 
 vector<ofxAAValue> availableValues {
     RMS,
@@ -52,9 +54,53 @@ vector<ofxAAValue> availableValues {
     SPECTRAL_ENTROPY,
     SPECTRAL_CENTROID,
     SPECTRAL_COMPLEXITY,
-    SPECTRAL_FLUX
+    SPECTRAL_FLUX,
+    
+    // Added channels go last, so existing channel indices don't move
+    MEL_BANDS_KURTOSIS,
+    MEL_BANDS_SPREAD,
+    MEL_BANDS_SKEWNESS,
+    MEL_BANDS_FLATNESS_DB,
+    MEL_BANDS_CREST,
+    
+    ERB_BANDS_KURTOSIS,
+    ERB_BANDS_SPREAD,
+    ERB_BANDS_SKEWNESS,
+    ERB_BANDS_FLATNESS_DB,
+    ERB_BANDS_CREST,
+    
+    BARK_BANDS_KURTOSIS,
+    BARK_BANDS_SPREAD,
+    BARK_BANDS_SKEWNESS,
+    BARK_BANDS_FLATNESS_DB,
+    BARK_BANDS_CREST,
+    
+    HARMONIC_SPECTRAL_TILT,
+    HARMONIC_ENERGY,
+    
+    HPCP_CREST,
+    HPCP_ENTROPY,
+    CHORD_INDEX,
+    CHORD_STRENGTH,
+    KEY_INDEX,
+    KEY_MODE,
+    KEY_STRENGTH,
+    
+    TEMPO_BPM,
+    TEMPO_CONFIDENCE,
+    BEAT_PULSE,
+    BEAT_PHASE
 };
 
+#define BANDS_MODE_OFF "Off"
+#define BANDS_MODE_OCTAVE "Octave"
+#define BANDS_MODE_THIRD_OCTAVE "Thirdoctave"
+#define BANDS_MODE_CUSTOM "Custom"
+
+#define INFO_TOP_NODES_NUM 5
+#define INFO_DAT_COLUMNS_NUM 9
+#define INFO_WATCHDOG_CHANS_NUM 2
+
 // These functions are basic C function, which the DLL loader can find
 // much easier than finding a C++ Class.
 // The DLLEXPORT prefix is needed so the compile exports these functions from the .dll
@@ -114,6 +160,10 @@ CPlusPlusCHOPExample::CPlusPlusCHOPExample(const OP_NodeInfo* info) : myNodeInfo
 {
 	myExecuteCount = 0;
 	myOffset = 0.0;
+	myIsProfiling = false;
+	myMeasuredPlanning = false;
+	myCookProfile.name = "cook";
+	myDegradeSteps = ofxaa::CookWatchdog::parseSteps("");
 }
 
 CPlusPlusCHOPExample::~CPlusPlusCHOPExample()
@@ -142,7 +192,9 @@ CPlusPlusCHOPExample::getOutputInfo(CHOP_OutputInfo* info, const OP_Inputs* inpu
 	// If there is an input connected, we are going to match it's channel names etc
 	// otherwise we'll specify our own.
 	
-    info->numChannels = availableValues.size();
+    updateBandEdges(inputs);
+    int bandsNum = myBandEdges.size() > 1 ? myBandEdges.size() - 1 : 0;
+    info->numChannels = availableValues.size() + bandsNum;
 
     // Since we are outputting a timeslice, the system will dictate
     // the numSamples and startIndex of the CHOP data
@@ -158,10 +210,39 @@ CPlusPlusCHOPExample::getOutputInfo(CHOP_OutputInfo* info, const OP_Inputs* inpu
 void
 CPlusPlusCHOPExample::getChannelName(int32_t index, OP_String *name, const OP_Inputs* inputs, void* reserved1)
 {
-    if (index >= availableValues.size()) { return ;}
+    int valuesNum = (int)availableValues.size();
+    if (index >= valuesNum) {
+        int band = index - valuesNum;
+        if (band + 1 >= (int)myBandEdges.size()) { return; }
+        string bandName = string(utils::binsValueTypeToString(ENERGY_BANDS)) + "-" + to_string(band);
+        name->setString(bandName.c_str());
+        return;
+    }
 	name->setString(utils::valueTypeToString(availableValues[index]));
 }
 
+bool
+CPlusPlusCHOPExample::updateBandEdges(const OP_Inputs* inputs)
+{
+    vector<float> edges;
+    const char* mode = inputs->getParString("Bandsmode");
+    if (mode && !strcmp(mode, BANDS_MODE_CUSTOM)) {
+        edges = ofxAAEnergyBandsAlgorithm::parseBandEdges(inputs->getParString("Bandedges"));
+    } else if (mode && !strcmp(mode, BANDS_MODE_THIRD_OCTAVE)) {
+        edges = ofxAAEnergyBandsAlgorithm::fractionalOctaveEdges(3);
+    } else if (mode && !strcmp(mode, BANDS_MODE_OCTAVE)) {
+        edges = ofxAAEnergyBandsAlgorithm::fractionalOctaveEdges(1);
+    }
+    if (edges.size() < 2) {
+        edges.clear();
+    }
+    if (edges == myBandEdges) {
+        return false;
+    }
+    myBandEdges = edges;
+    return true;
+}
+
 void
 CPlusPlusCHOPExample::execute(CHOP_Output* output,
                               const OP_Inputs* inputs,
@@ -169,10 +250,46 @@ CPlusPlusCHOPExample::execute(CHOP_Output* output,
 {
     myExecuteCount++;
     
+    auto cookStart = ofxaa::ProfileClock::now();
+    bool profiling = inputs->getParInt("Profile") != 0;
+    if (profiling != myIsProfiling) {
+        myIsProfiling = profiling;
+        myCookProfile.reset();
+        myNodeProfiles.clear();
+        myTopNodes.clear();
+    }
+    bool tracing = inputs->getParInt("Trace") != 0;
+    const char* traceFile = inputs->getParFilePath("Tracefile");
+    myTraceFile = traceFile ? traceFile : "";
+    
+    double budget = inputs->getParDouble("Budget");
+    const char* degradeOrder = inputs->getParString("Degradeorder");
+    if (degradeOrder && myDegradeOrder != degradeOrder) {
+        myDegradeOrder = degradeOrder;
+        myDegradeSteps = ofxaa::CookWatchdog::parseSteps(myDegradeOrder);
+    }
+    
     double smoothing = inputs->getParDouble("Smoothing");
     double alpha = inputs->getParDouble("Alpha");
     double timeThresh = inputs->getParDouble("Timethreshold");
     double silenceThresh = inputs->getParDouble("Silencethreshold");
+    bool pitchTracking = inputs->getParInt("Pitchtracking") != 0;
+    bool sharing = inputs->getParInt("Shareanalysis") != 0;
+    
+    // One analysis frame per cook: its period is the timeline time since the last cook,
+    // which holds in realtime and non realtime cooks alike.
+    const OP_TimeInfo* timeInfo = inputs->getTimeInfo();
+    double framePeriod = 0.0;
+    if (timeInfo && timeInfo->rate > 0.0) {
+        framePeriod = std::max(timeInfo->deltaFrames, 1.0) / timeInfo->rate;
+    }
+    // Process wide, applies to the analyzers of every CHOP built from now on.
+    // Only a change of this CHOP's toggle is applied, so the CHOPs left alone don't override it.
+    bool measuredPlanning = inputs->getParInt("Measuredplanning") != 0;
+    if (measuredPlanning != myMeasuredPlanning) {
+        myMeasuredPlanning = measuredPlanning;
+        ofxaa::Runtime::instance().setMeasuredPlanning(measuredPlanning);
+    }
     
     // One and only one input needed
     if (inputs->getNumInputs() != 1) {
@@ -185,30 +302,149 @@ CPlusPlusCHOPExample::execute(CHOP_Output* output,
     auto bufferSize = cinput->numSamples;
     auto channels = cinput->numChannels;
     
+    int bandsNum = myBandEdges.size() > 1 ? myBandEdges.size() - 1 : 0;
     bool isValidBuffer = (bufferSize % 2 == 0);
-    if (!isValidBuffer || availableValues.size() != output->numChannels) {
+    if (!isValidBuffer || (int)availableValues.size() + bandsNum != output->numChannels) {
         return;
     }
-    audioAnalyzer.setup(sampleRate, bufferSize, channels);
-    audioAnalyzer.setOnsetsParameters(0, alpha, silenceThresh, timeThresh);
-    audioAnalyzer.analyze(*cinput);
     
-    for (int i = 0 ; i < output->numChannels; i++)
+    // CHOPs analyzing the same input with the same parameters share one analyzer,
+    // the first of them to cook analyzes the input for all. Smoothing is applied per CHOP.
+    std::ostringstream config;
+    config << alpha << " " << timeThresh << " " << silenceThresh << " " << pitchTracking << " "
+           << budget << " " << myDegradeOrder << " " << profiling << " " << tracing << " |";
+    for (auto edge : myBandEdges) {
+        config << " " << edge;
+    }
+    if (!sharing) {
+        config << " | " << myNodeInfo->opId;
+    }
+    myAnalysis = ofxaa::AnalysisRegistry::instance().acquire(cinput->opId, config.str(), myAnalysis);
+    
+    std::lock_guard<std::mutex> lock(myAnalysis->mutex);
+    ofxAudioAnalyzer& audioAnalyzer = myAnalysis->analyzer;
+    if (myAnalysis->beginCook(cinput->totalCooks)) {
+        audioAnalyzer.setProfiling(profiling);
+        audioAnalyzer.setTracing(tracing);
+        audioAnalyzer.setCookBudget(budget);
+        audioAnalyzer.setDegradationSteps(myDegradeSteps);
+        audioAnalyzer.setFramePeriod(framePeriod);
+        audioAnalyzer.setup(sampleRate, bufferSize, channels);
+        
+        // Units for a new format are built in the background: the analyzer keeps its
+        // previous format meanwhile, and has no channels before the first build is ready.
+        int analyzerChannels = audioAnalyzer.getChannelsNum();
+        if (analyzerChannels > 0) {
+            audioAnalyzer.setOnsetsParameters(0, alpha, silenceThresh, timeThresh);
+            for (int ch = 0; ch < analyzerChannels; ch++) {
+                audioAnalyzer.setPitchTracking(ch, pitchTracking);
+            }
+            if (bandsNum > 0) {
+                for (int ch = 0; ch < analyzerChannels; ch++) {
+                    audioAnalyzer.setEnergyBandsEdges(ch, myBandEdges);
+                }
+            }
+            audioAnalyzer.analyze(*cinput);
+        }
+    }
+    
+    int analyzerChannels = audioAnalyzer.getChannelsNum();
+    if (analyzerChannels == 0) {
+        for (int i = 0; i < output->numChannels; i++) {
+            std::fill(output->channels[i], output->channels[i] + output->numSamples, 0.0f);
+        }
+        return;
+    }
+    
+    if ((int)mySmoothedValues.size() != output->numChannels) {
+        mySmoothedValues.assign(output->numChannels, 0.0f);
+    }
+    
+    for (int i = 0 ; i < (int)availableValues.size(); i++)
+    {
+        auto valueType = availableValues[i];
+        float value = smooth(audioAnalyzer.getAverageValue(valueType, 0.0, false), i, smoothing);
+        for (int j = 0; j < output->numSamples; j++)
+        {
+            output->channels[i][j] = value;
+        }
+    }
+    
+    //ENERGY BANDS: averaged over input channels
+    for (int b = 0; b < bandsNum; b++)
     {
+        float value = 0.0;
+        for (int ch = 0; ch < analyzerChannels; ch++) {
+            // Units of a new format may still have other bands for a frame
+            auto& bands = audioAnalyzer.getValues(ENERGY_BANDS, ch, 0.0, false);
+            if (b < (int)bands.size()) {
+                value += bands[b];
+            }
+        }
+        value /= analyzerChannels;
+        
+        int channelIndex = availableValues.size() + b;
+        value = smooth(value, channelIndex, smoothing);
         for (int j = 0; j < output->numSamples; j++)
         {
-            auto valueType = availableValues[i];
-            output->channels[i][j] = audioAnalyzer.getAverageValue(valueType, smoothing, false);
+            output->channels[channelIndex][j] = value;
+        }
+    }
+    
+    if (myIsProfiling) {
+        myCookProfile.add(ofxaa::elapsedMicros(cookStart, ofxaa::ProfileClock::now()));
+        updateNodeProfiles(audioAnalyzer);
+    }
+}
+
+float
+CPlusPlusCHOPExample::smooth(float value, int channel, double amount)
+{
+    mySmoothedValues[channel] = mySmoothedValues[channel] * amount + (1.0 - amount) * value;
+    return mySmoothedValues[channel];
+}
+
+void
+CPlusPlusCHOPExample::updateNodeProfiles(ofxAudioAnalyzer& audioAnalyzer)
+{
+    // Profiles are merged in place, so after the first cook nothing is allocated
+    for (int ch = 0; ch < audioAnalyzer.getChannelsNum(); ch++) {
+        auto& profiles = audioAnalyzer.getNodeProfiles(ch);
+        if (ch == 0) {
+            myNodeProfiles.resize(profiles.size());
+            for (size_t i = 0; i < profiles.size(); i++) {
+                myNodeProfiles[i] = profiles[i];
+            }
+            continue;
         }
+        for (size_t i = 0; i < profiles.size() && i < myNodeProfiles.size(); i++) {
+            myNodeProfiles[i].merge(profiles[i]);
+        }
+    }
+    
+    myTopNodes.resize(myNodeProfiles.size());
+    for (int i = 0; i < (int)myTopNodes.size(); i++) {
+        myTopNodes[i] = i;
     }
+    int topNum = std::min((int)myTopNodes.size(), INFO_TOP_NODES_NUM);
+    std::partial_sort(myTopNodes.begin(), myTopNodes.begin() + topNum, myTopNodes.end(),
+                      [this](int a, int b) {
+                          return myNodeProfiles[a].smoothedMicros > myNodeProfiles[b].smoothedMicros;
+                      });
 }
 
 int32_t
 CPlusPlusCHOPExample::getNumInfoCHOPChans(void * reserved1)
 {
-	// We return the number of channel we want to output to any Info CHOP
-	// connected to the CHOP. In this example we are just going to send one channel.
-	return 2;
+	// The degradation level and the cost it was decided on are always published.
+	// Timings only while the Profile parameter is on:
+	// the cook time, the network time of each input channel and the most expensive nodes.
+	if (!myIsProfiling || !myAnalysis) {
+		return INFO_WATCHDOG_CHANS_NUM;
+	}
+	std::lock_guard<std::mutex> lock(myAnalysis->mutex);
+	int32_t topNum = std::min((int)myTopNodes.size(), INFO_TOP_NODES_NUM);
+	return INFO_WATCHDOG_CHANS_NUM + 1 + myAnalysis->analyzer.getChannelsNum() + topNum;
 }
 
 void
@@ -216,27 +452,65 @@ CPlusPlusCHOPExample::getInfoCHOPChan(int32_t index,
 										OP_InfoCHOPChan* chan,
 										void* reserved1)
 {
-	// This function will be called once for each channel we said we'd want to return
-	// In this example it'll only be called once.
+	if (!myAnalysis) {
+		chan->name->setString(index == 0 ? "degradation_level" : "budget_p95_us");
+		chan->value = 0.0f;
+		return;
+	}
+	std::lock_guard<std::mutex> lock(myAnalysis->mutex);
+	ofxAudioAnalyzer& audioAnalyzer = myAnalysis->analyzer;
 
 	if (index == 0)
 	{
-		chan->name->setString("executeCount");
-		chan->value = (float)myExecuteCount;
+		chan->name->setString("degradation_level");
+		chan->value = (float)audioAnalyzer.getDegradationLevel();
+		return;
 	}
-
 	if (index == 1)
 	{
-		chan->name->setString("offset");
-		chan->value = (float)myOffset;
+		chan->name->setString("budget_p95_us");
+		chan->value = (float)audioAnalyzer.getCookPercentile();
+		return;
+	}
+	index -= INFO_WATCHDOG_CHANS_NUM;
+
+	if (index == 0)
+	{
+		chan->name->setString("cook_us");
+		chan->value = (float)myCookProfile.smoothedMicros;
+		return;
+	}
+
+	int channelsNum = audioAnalyzer.getChannelsNum();
+	if (index <= channelsNum)
+	{
+		int ch = index - 1;
+		string name = "network_us_ch" + to_string(ch);
+		chan->name->setString(name.c_str());
+		chan->value = (float)audioAnalyzer.getComputeProfile(ch).smoothedMicros;
+		return;
+	}
+
+	int top = index - channelsNum - 1;
+	if (top < (int)myTopNodes.size())
+	{
+		auto& profile = myNodeProfiles[myTopNodes[top]];
+		string name = "top" + to_string(top + 1) + "_" + profile.name + "_us";
+		chan->name->setString(name.c_str());
+		chan->value = (float)profile.smoothedMicros;
 	}
 }
 
 bool		
 CPlusPlusCHOPExample::getInfoDATSize(OP_InfoDATSize* infoSize, void* reserved1)
 {
-	infoSize->rows = 2;
-	infoSize->cols = 2;
+	// One row per network node, merged over the input channels, under a header row.
+	// Only published while the Profile parameter is on.
+	if (!myIsProfiling) {
+		return false;
+	}
+	infoSize->rows = 1 + (int32_t)myNodeProfiles.size();
+	infoSize->cols = INFO_DAT_COLUMNS_NUM;
 	// Setting this to false means we'll be assigning values to the table
 	// one row at a time. True means we'll do it one column at a time.
 	infoSize->byColumn = false;
@@ -249,34 +523,43 @@ CPlusPlusCHOPExample::getInfoDATEntries(int32_t index,
 										OP_InfoDATEntries* entries, 
 										void* reserved1)
 {
-	char tempBuffer[4096];
-
 	if (index == 0)
 	{
-		// Set the value for the first column
-		entries->values[0]->setString("executeCount");
-
-		// Set the value for the second column
-#ifdef _WIN32
-		sprintf_s(tempBuffer, "%d", myExecuteCount);
-#else // macOS
-		snprintf(tempBuffer, sizeof(tempBuffer), "%d", myExecuteCount);
-#endif
-		entries->values[1]->setString(tempBuffer);
+		const char* header[INFO_DAT_COLUMNS_NUM] = { "node", "calls", "mean_us", "p50_us", "p95_us", "p99_us", "max_us", "skipped", "output_bytes" };
+		for (int i = 0; i < nEntries && i < INFO_DAT_COLUMNS_NUM; i++) {
+			entries->values[i]->setString(header[i]);
+		}
+		return;
 	}
-
-	if (index == 1)
-	{
-		// Set the value for the first column
-		entries->values[0]->setString("offset");
-
-		// Set the value for the second column
+	
+	int node = index - 1;
+	if (node >= (int)myNodeProfiles.size() || nEntries < INFO_DAT_COLUMNS_NUM) {
+		return;
+	}
+	auto& profile = myNodeProfiles[node];
+	double values[INFO_DAT_COLUMNS_NUM - 1] = {
+		(double)profile.calls,
+		profile.getMeanMicros(),
+		profile.getPercentileMicros(0.5),
+		profile.getPercentileMicros(0.95),
+		profile.getPercentileMicros(0.99),
+		profile.maxMicros,
+		(double)profile.skipped,
+		(double)profile.outputBytes
+	};
+	
+	// Counts and bytes as integers, times with two decimals
+	const char* formats[INFO_DAT_COLUMNS_NUM - 1] = { "%.0f", "%.2f", "%.2f", "%.2f", "%.2f", "%.2f", "%.0f", "%.0f" };
+	
+	char tempBuffer[64];
+	entries->values[0]->setString(profile.name.c_str());
+	for (int i = 0; i < INFO_DAT_COLUMNS_NUM - 1; i++) {
 #ifdef _WIN32
-		sprintf_s(tempBuffer, "%g", myOffset);
+		sprintf_s(tempBuffer, formats[i], values[i]);
 #else // macOS
-		snprintf(tempBuffer, sizeof(tempBuffer), "%g", myOffset);
+		snprintf(tempBuffer, sizeof(tempBuffer), formats[i], values[i]);
 #endif
-		entries->values[1]->setString( tempBuffer);
+		entries->values[i + 1]->setString(tempBuffer);
 	}
 }
 
@@ -339,6 +622,144 @@ CPlusPlusCHOPExample::setupParameters(OP_ParameterManager* manager, void *reserv
         assert(res == OP_ParAppendResult::Success);
     }
 
+    // Pitch tracking
+    {
+        OP_NumericParameter    np;
+
+        np.name = "Pitchtracking";
+        np.label = "Pitch Tracking";
+        np.defaultValues[0] = 0.0;
+
+        OP_ParAppendResult res = manager->appendToggle(np);
+        assert(res == OP_ParAppendResult::Success);
+    }
+
+    // Energy bands, off by default so the channel layout stays as it was
+    {
+        OP_StringParameter    sp;
+
+        sp.name = "Bandsmode";
+        sp.label = "Energy Bands";
+        sp.defaultValue = BANDS_MODE_OFF;
+
+        const char *names[] = { BANDS_MODE_OFF, BANDS_MODE_OCTAVE, BANDS_MODE_THIRD_OCTAVE, BANDS_MODE_CUSTOM };
+        const char *labels[] = { "Off", "Octave", "Third Octave", "Custom Edges" };
+
+        OP_ParAppendResult res = manager->appendMenu(sp, 4, names, labels);
+        assert(res == OP_ParAppendResult::Success);
+    }
+
+    // Band edges, used by Custom mode
+    {
+        OP_StringParameter    sp;
+
+        sp.name = "Bandedges";
+        sp.label = "Band Edges (Hz)";
+        sp.defaultValue = "20 150 800 4000 20000";
+
+        OP_ParAppendResult res = manager->appendString(sp);
+        assert(res == OP_ParAppendResult::Success);
+    }
+
+    // Profile
+    {
+        OP_NumericParameter    np;
+
+        np.name = "Profile";
+        np.label = "Profile";
+        np.defaultValues[0] = 0.0;
+
+        OP_ParAppendResult res = manager->appendToggle(np);
+        assert(res == OP_ParAppendResult::Success);
+    }
+
+    // Cook budget, 0 for none
+    {
+        OP_NumericParameter    np;
+
+        np.name = "Budget";
+        np.label = "Cook Budget (us)";
+        np.defaultValues[0] = 0.0;
+        np.minValues[0] = 0.0;
+        np.clampMins[0] = true;
+        np.minSliders[0] = 0.0;
+        np.maxSliders[0] = 20000.0;
+
+        OP_ParAppendResult res = manager->appendFloat(np);
+        assert(res == OP_ParAppendResult::Success);
+    }
+
+    // Degradation steps over budget, in order: rate, optional, frame
+    {
+        OP_StringParameter    sp;
+
+        sp.name = "Degradeorder";
+        sp.label = "Degrade Order";
+        sp.defaultValue = "rate optional frame";
+
+        OP_ParAppendResult res = manager->appendString(sp);
+        assert(res == OP_ParAppendResult::Success);
+    }
+
+    // Trace
+    {
+        OP_NumericParameter    np;
+
+        np.name = "Trace";
+        np.label = "Trace";
+        np.defaultValues[0] = 0.0;
+
+        OP_ParAppendResult res = manager->appendToggle(np);
+        assert(res == OP_ParAppendResult::Success);
+    }
+
+    // Trace file, Chrome Trace Event JSON
+    {
+        OP_StringParameter    sp;
+
+        sp.name = "Tracefile";
+        sp.label = "Trace File";
+        sp.defaultValue = "audioanalyzer_trace.json";
+
+        OP_ParAppendResult res = manager->appendFile(sp);
+        assert(res == OP_ParAppendResult::Success);
+    }
+
+    {
+        OP_NumericParameter    np;
+
+        np.name = "Dumptrace";
+        np.label = "Dump Trace";
+
+        OP_ParAppendResult res = manager->appendPulse(np);
+        assert(res == OP_ParAppendResult::Success);
+    }
+
+    // Share the analysis with the CHOPs on the same input and parameters
+    {
+        OP_NumericParameter    np;
+
+        np.name = "Shareanalysis";
+        np.label = "Share Analysis";
+        np.defaultValues[0] = 1.0;
+
+        OP_ParAppendResult res = manager->appendToggle(np);
+        assert(res == OP_ParAppendResult::Success);
+    }
+
+    // FFTW_MEASURE plans, measured once and kept in the FFTW wisdom file.
+    // Process wide: shared by every CHOP of this plugin.
+    {
+        OP_NumericParameter    np;
+
+        np.name = "Measuredplanning";
+        np.label = "Measured FFT Planning (Process Wide)";
+        np.defaultValues[0] = 0.0;
+
+        OP_ParAppendResult res = manager->appendToggle(np);
+        assert(res == OP_ParAppendResult::Success);
+    }
+
 	// pulse
 	{
 		OP_NumericParameter	np;
@@ -355,9 +776,18 @@ CPlusPlusCHOPExample::setupParameters(OP_ParameterManager* manager, void *reserv
 void 
 CPlusPlusCHOPExample::pulsePressed(const char* name, void* reserved1)
 {
-	if (!strcmp(name, "Resetonsets"))
+	// Acts on the analysis shared with the CHOPs on the same input
+	if (!myAnalysis) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(myAnalysis->mutex);
+	if (!strcmp(name, "Resetonsets") && myAnalysis->analyzer.getChannelsNum() > 0)
+	{
+        myAnalysis->analyzer.resetOnsets(0);
+	}
+	if (!strcmp(name, "Dumptrace") && !myTraceFile.empty())
 	{
-        audioAnalyzer.resetOnsets(0);
+        myAnalysis->analyzer.writeTrace(myTraceFile);
 	}
 }
 
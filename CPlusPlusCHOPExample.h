@@ -14,6 +14,7 @@
 
 #include "CHOP_CPlusPlusBase.h"
 #include "ofxAudioAnalyzer.h"
+#include "ofxAAAnalysisRegistry.h"
 
 /*
 
@@ -63,6 +64,13 @@ public:
 
 private:
 
+    ///Reads the energy bands parameters. Returns true if the edges changed.
+    bool                updateBandEdges(const OP_Inputs* inputs);
+    ///Merges the node profiles of all channels and finds the most expensive nodes.
+    void                updateNodeProfiles(ofxAudioAnalyzer& audioAnalyzer);
+    ///Smooths value with the previous output of channel, per CHOP since the analysis is shared.
+    float               smooth(float value, int channel, double amount);
+
 	// We don't need to store this pointer, but we do for the example.
 	// The OP_NodeInfo class store information about the node that's using
 	// this instance of the class (like its name).
@@ -71,7 +79,22 @@ private:
 	// In this example this value will be incremented each time the execute()
 	// function is called, then passes back to the CHOP 
 	int32_t				myExecuteCount;
-    ofxAudioAnalyzer    audioAnalyzer;
+    ///Analysis of the input, shared with the CHOPs on the same input and parameters.
+    std::shared_ptr<ofxaa::SharedAnalysis> myAnalysis;
+    vector<float>       mySmoothedValues;
+    vector<float>       myBandEdges;
+    
+    bool                myIsProfiling;
+    ofxaa::NodeProfile  myCookProfile;
+    vector<ofxaa::NodeProfile> myNodeProfiles;
+    ///Indices into myNodeProfiles, most expensive first.
+    vector<int>         myTopNodes;
+    
+    string              myTraceFile;
+    ///Last value of the Measuredplanning toggle, applied to the process wide runtime on change.
+    bool                myMeasuredPlanning;
+    string              myDegradeOrder;
+    vector<ofxaa::DegradationStep> myDegradeSteps;
 
 
 	double				myOffset;
@@ -100,12 +100,23 @@ namespace utils {
         {"PITCH-SALIENCE", PITCH_SALIENCE},
         {"INHARMONICITY", INHARMONICITY},
         {"ODD-EVEN", ODD_TO_EVEN},
+        {"HARMONIC-TILT", HARMONIC_SPECTRAL_TILT},
+        {"HARMONIC-ENERGY", HARMONIC_ENERGY},
         {"STRONG-PEAK", STRONG_PEAK},
         {"HPCP-CREST", HPCP_CREST},
         {"HPCP-ENTROPY", HPCP_ENTROPY},
+        {"CHORD-INDEX", CHORD_INDEX},
+        {"CHORD-STRENGTH", CHORD_STRENGTH},
+        {"KEY-INDEX", KEY_INDEX},
+        {"KEY-MODE", KEY_MODE},
+        {"KEY-STRENGTH", KEY_STRENGTH},
         {"PITCH-FREQUENCY", PITCH_YIN_FREQUENCY},
         {"PITCH-CONFIDENCE", PITCH_YIN_CONFIDENCE},
         {"ONSETS", ONSETS},
+        {"TEMPO-BPM", TEMPO_BPM},
+        {"TEMPO-CONFIDENCE", TEMPO_CONFIDENCE},
+        {"BEAT-PULSE", BEAT_PULSE},
+        {"BEAT-PHASE", BEAT_PHASE},
         {"NONE", NONE}
     };
     
@@ -114,6 +125,8 @@ namespace utils {
         {"MEL-BANDS", MFCC_MEL_BANDS},
         {"GFCC-ERB-BANDS", GFCC_ERB_BANDS},
         {"BARK-BANDS", BARK_BANDS},
+        {"ENERGY-BANDS", ENERGY_BANDS},
+        {"CONSTANT-Q", CONSTANT_Q},
         {"TRISTIMULUS", TRISTIMULUS},
         {"HPCP", HPCP},
         {"PITCH_MELODIA_FREQUENCIES", PITCH_MELODIA_FREQUENCIES},
@@ -108,7 +108,26 @@ namespace ofxaa {
         PitchMelodia,
         MultiPitchKlapuri,
         MultiPitchMelodia,
-        PredominantPitchMelodia
+        PredominantPitchMelodia,
+        
+        ///NATIVE: computed in ofxAudioAnalyzer, no Essentia algorithm is created
+        PowerSpectrum,
+        PowerEnergyIndex,
+        PowerEnergyBand,
+        PowerEnergyBands,
+        PowerRollOff,
+        Filterbank,
+        SpectralPeaksSet,
+        SpectralPeaksView,
+        HarmonicDescriptors,
+        BoundedDissonance,
+        PowerPitchYinFFT,
+        ConstantQ,
+        StreamingChords,
+        RunningKey,
+        NoveltyTempo,
+        BeatTracker,
+        SharedWindowing
     };
 
 }
@@ -37,6 +37,7 @@ ofxAABaseAlgorithm::ofxAABaseAlgorithm(ofxaa::AlgorithmType algorithmType, int s
     algorithm = ofxaa::createAlgorithmWithType(_algorithmType, samplerate, framesize);
     
     isActive = true;
+    updateInterval = 1;
     
     hasLogarithmicValues = false;
     hasDbValues = false;
@@ -56,6 +57,23 @@ void ofxAABaseAlgorithm::deleteAlgorithm(){
     delete algorithm;
 }
 //-------------------------------------------
+void ofxAABaseAlgorithm::saveDefaults(){
+    _defaultIsActive = isActive;
+    _defaultMinEstimatedValue = minEstimatedValue;
+    _defaultMaxEstimatedValue = maxEstimatedValue;
+}
+//-------------------------------------------
+void ofxAABaseAlgorithm::resetAlgorithm(){
+    //Native algorithms have no Essentia algorithm.
+    if (algorithm != NULL){
+        algorithm->reset();
+    }
+    isActive = _defaultIsActive;
+    updateInterval = 1;
+    minEstimatedValue = _defaultMinEstimatedValue;
+    maxEstimatedValue = _defaultMaxEstimatedValue;
+}
+//-------------------------------------------
 float ofxAABaseAlgorithm::smooth(float newValue, float previousValue, float amount){
     return previousValue * amount + (1-amount) * newValue;
 }
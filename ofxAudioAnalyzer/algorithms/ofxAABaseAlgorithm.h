@@ -26,6 +26,7 @@
 
 ///
 #include "ofxAAAlgorithmTypes.h"
+#include "ofxAAArena.h"
 
 #include "algorithmfactory.h"
 #include "essentiamath.h"
@@ -51,9 +52,22 @@ public:
     
     virtual void deleteAlgorithm();
     
+    ///Reserves the algorithm's fixed-size buffers in the Network arena.
+    virtual void reserveBuffers(ofxaa::Arena&){}
+    
+    ///Size of the output buffers, reported by the Network profiler.
+    virtual size_t getOutputBytes(){ return 0; }
+    
+    ///Keeps the current settings as the ones resetAlgorithm() restores. Called once the Network is configured.
+    virtual void saveDefaults();
+    ///Clears the state carried between frames and restores the saved settings, as if just built.
+    virtual void resetAlgorithm();
+    
     Algorithm* algorithm;
     
     bool isActive;
+    ///The Network computes this algorithm one frame out of updateInterval and holds its outputs in between.
+    int updateInterval;
 
     float minEstimatedValue;
     float maxEstimatedValue;
@@ -66,4 +80,8 @@ protected:
     float smooth(float newValue, float previousValue, float amount);
     ofxaa::AlgorithmType _algorithmType;
     
+    bool _defaultIsActive = true;
+    float _defaultMinEstimatedValue = 0.0;
+    float _defaultMaxEstimatedValue = 1.0;
+    
 };
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#include "ofxAABeatTrackerAlgorithm.h"
+
+#define BEAT_NOVELTY_SIZE (BEAT_CORRECTION_LAG * 2 + 1)
+#define BEAT_NOVELTY_MEAN_SMOOTHING 0.02
+#define BEAT_MAX_PHASE_ERROR 0.25
+
+ofxAABeatTrackerAlgorithm::ofxAABeatTrackerAlgorithm(int samplerate, int framesize) : ofxAAOneVectorOutputAlgorithm(ofxaa::BeatTracker, samplerate, framesize, 2) {
+    _onsets = NULL;
+    _tempo = NULL;
+    reset();
+}
+//-------------------------------------------
+void ofxAABeatTrackerAlgorithm::setInputs(ofxAAOnsetsAlgorithm* onsets, ofxAATempoAlgorithm* tempo){
+    _onsets = onsets;
+    _tempo = tempo;
+}
+//-------------------------------------------
+void ofxAABeatTrackerAlgorithm::reset(){
+    _phase = 0.0;
+    _beatPeriod = 0.0;
+    _isLocked = false;
+    _lowConfidenceTime = 0.0;
+    _uncorrectedTime = 0.0;
+    for (int i=0; i<BEAT_NOVELTY_SIZE; i++){ _novelty[i] = 0.0; }
+    _noveltyMean = 0.0;
+    outputValues[0] = 0.0;
+    outputValues[1] = 0.0;
+}
+//-------------------------------------------
+void ofxAABeatTrackerAlgorithm::resetAlgorithm(){
+    ofxAAOneVectorOutputAlgorithm::resetAlgorithm();
+    reset();
+}
+//-------------------------------------------
+void ofxAABeatTrackerAlgorithm::compute(){
+    outputValues[0] = 0.0;
+    if (!isActive || _onsets == NULL || _tempo == NULL){
+        outputValues[1] = 0.0;
+        return;
+    }
+    
+    for (int i=0; i<BEAT_NOVELTY_SIZE-1; i++){ _novelty[i] = _novelty[i+1]; }
+    Real novelty = _onsets->getNoveltyValue();
+    _novelty[BEAT_NOVELTY_SIZE-1] = novelty;
+    _noveltyMean += BEAT_NOVELTY_MEAN_SMOOTHING * (novelty - _noveltyMean);
+    
+    //Peak confirmed BEAT_CORRECTION_LAG frames ago.
+    Real candidate = _novelty[BEAT_CORRECTION_LAG];
+    bool isPeak = candidate > BEAT_PEAK_RATIO * _noveltyMean;
+    for (int i=0; i<BEAT_NOVELTY_SIZE && isPeak; i++){
+        if (i != BEAT_CORRECTION_LAG && _novelty[i] > candidate){ isPeak = false; }
+    }
+    
+    //The loop locks on a peak of a confident tempo; it keeps its own period once locked.
+    Real tempoPeriod = _tempo->getBeatPeriod();
+    bool hasTempo = tempoPeriod > 0.0 && _tempo->outputValues[1] >= BEAT_MIN_TEMPO_CONFIDENCE;
+    Real framePeriod = _tempo->getFramePeriod();
+    if (!_isLocked){
+        if (!hasTempo || !isPeak){ return; }
+        //The peak was a beat BEAT_CORRECTION_LAG frames ago.
+        _beatPeriod = tempoPeriod;
+        _phase = BEAT_CORRECTION_LAG * framePeriod / _beatPeriod;
+        _isLocked = true;
+        _lowConfidenceTime = 0.0;
+        _uncorrectedTime = 0.0;
+        outputValues[1] = _phase;
+        return;
+    }
+    if (hasTempo){
+        _lowConfidenceTime = 0.0;
+        //Follow tempo changes, but not octave jumps of the estimation.
+        Real ratio = tempoPeriod / _beatPeriod;
+        if (ratio > 0.8 && ratio < 1.25){
+            _beatPeriod += BEAT_PERIOD_GAIN * (tempoPeriod - _beatPeriod);
+        }
+    } else {
+        _lowConfidenceTime += framePeriod;
+    }
+    _uncorrectedTime += framePeriod;
+    
+    _phase += framePeriod / _beatPeriod;
+    if (_phase >= 1.0){
+        _phase -= floor(_phase);
+        outputValues[0] = 1.0;
+    }
+    
+    if (isPeak && correctPhase(candidate)){
+        _uncorrectedTime = 0.0;
+    }
+    
+    Real unlockTime = BEAT_UNLOCK_BEATS * _beatPeriod;
+    if (_lowConfidenceTime > unlockTime || _uncorrectedTime > unlockTime){
+        unlock();
+        return;
+    }
+    outputValues[1] = _phase;
+}
+//-------------------------------------------
+void ofxAABeatTrackerAlgorithm::unlock(){
+    _isLocked = false;
+    _phase = 0.0;
+    outputValues[0] = 0.0;
+    outputValues[1] = 0.0;
+}
+//-------------------------------------------
+bool ofxAABeatTrackerAlgorithm::correctPhase(Real peakValue){
+    //Phase the peak happened at, relative to the nearest predicted beat.
+    Real lagPhase = BEAT_CORRECTION_LAG * _tempo->getFramePeriod() / _beatPeriod;
+    Real error = _phase - lagPhase;
+    error -= floor(error + 0.5);
+    if (fabs(error) > BEAT_MAX_PHASE_ERROR){ return false; }
+    
+    //Stronger peaks pull harder: a peak of twice the threshold gets the full gain.
+    Real weight = std::min((Real)1.0, Real(peakValue / (2.0 * BEAT_PEAK_RATIO * _noveltyMean)));
+    _phase -= BEAT_PHASE_GAIN * weight * error;
+    _beatPeriod *= 1.0 + BEAT_PERIOD_GAIN * weight * error;
+    
+    //A late beat already pulsed holds at 0 instead of pulsing twice, an early one pulses now.
+    if (_phase < 0.0){
+        _phase = 0.0;
+    } else if (_phase >= 1.0){
+        _phase -= 1.0;
+        outputValues[0] = 1.0;
+    }
+    return true;
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#pragma once
+
+#include "ofxAAOneVectorOutputAlgorithm.h"
+#include "ofxAAOnsetsAlgorithm.h"
+#include "ofxAATempoAlgorithm.h"
+
+#define BEAT_MIN_TEMPO_CONFIDENCE 0.3
+#define BEAT_CORRECTION_LAG 2 //frames a detection function peak waits to be confirmed
+#define BEAT_PHASE_GAIN 0.3
+#define BEAT_PERIOD_GAIN 0.05
+#define BEAT_PEAK_RATIO 1.5 //peaks over this times the running mean correct the phase
+#define BEAT_UNLOCK_BEATS 4.0 //beat periods without a confident tempo or a correcting peak before the loop unlocks
+
+///Causal beat tracker: a phase-locked loop on the beat period of ofxAATempoAlgorithm.
+///The phase advances every frame and is corrected, with BEAT_CORRECTION_LAG frames of delay, by the
+///detection function peaks near the predicted beats. No lookahead, constant cost per frame.
+///The loop locks on a detection function peak once the tempo is confident. It unlocks, with the phase at 0,
+///after BEAT_UNLOCK_BEATS beat periods of a low tempo confidence or without correcting peaks,
+///so silence and non rhythmic material don't keep pulsing.
+///outputValues[0] is 1 on the frame a beat is predicted and 0 otherwise, outputValues[1] the beat phase (0-1).
+class ofxAABeatTrackerAlgorithm : public ofxAAOneVectorOutputAlgorithm {
+public:
+    
+    ofxAABeatTrackerAlgorithm(int samplerate, int framesize);
+    
+    void compute() override;
+    
+    void setInputs(ofxAAOnsetsAlgorithm* onsets, ofxAATempoAlgorithm* tempo);
+    
+    void reset();
+    void resetAlgorithm() override;
+    
+private:
+    ///Returns false when the peak is too far from the predicted beat to correct it.
+    bool correctPhase(Real peakValue);
+    void unlock();
+    
+    ofxAAOnsetsAlgorithm* _onsets;
+    ofxAATempoAlgorithm* _tempo;
+    
+    Real _phase;
+    Real _beatPeriod;///seconds, follows the tempo estimation with the loop's own correction
+    bool _isLocked;
+    Real _lowConfidenceTime;///seconds since the tempo was last confident
+    Real _uncorrectedTime;///seconds since the last phase correction
+    
+    ///Last BEAT_CORRECTION_LAG * 2 + 1 detection function values, newest last.
+    Real _novelty[BEAT_CORRECTION_LAG * 2 + 1];
+    Real _noveltyMean;
+    
+};
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#include "ofxAAChordsAlgorithm.h"
+#include "ofxAAPitchClassTemplates.h"
+
+ofxAAChordsAlgorithm::ofxAAChordsAlgorithm(int samplerate, int framesize, Real windowSize) : ofxAAOneVectorOutputAlgorithm(ofxaa::StreamingChords, samplerate, framesize, 2) {
+    _hpcp = NULL;
+    _framePeriod = Real(framesize) / samplerate;
+    buildTemplates();
+    _defaultWindowSize = windowSize;
+    setWindowSize(windowSize);
+}
+//-------------------------------------------
+void ofxAAChordsAlgorithm::buildTemplates(){
+    //Major: root, major third, fifth. Minor: root, minor third, fifth.
+    for (int c=0; c<CHORDS_NUMBER; c++){
+        int root = c % 12;
+        int third = c < 12 ? 4 : 3;
+        Real* t = _templates[c];
+        for (int i=0; i<12; i++){ t[i] = 0.0; }
+        t[root] = 1.0;
+        t[(root + third) % 12] = 1.0;
+        t[(root + 7) % 12] = 1.0;
+        ofxaa::normalizeTemplate(t);
+    }
+}
+//-------------------------------------------
+void ofxAAChordsAlgorithm::setWindowSize(Real windowSize){
+    _windowSize = windowSize;
+    _windowFrames = std::max(1, int(round(_windowSize / _framePeriod)));
+    _ring.assign(_windowFrames * 12, 0.0);
+    _ringIndex = 0;
+    for (int i=0; i<12; i++){ _sum[i] = 0.0; }
+}
+//-------------------------------------------
+void ofxAAChordsAlgorithm::setFramePeriod(Real seconds){
+    _framePeriod = seconds;
+    int frames = std::max(1, int(round(_windowSize / _framePeriod)));
+    if (frames == _windowFrames){ return; }
+    
+    //Newest frames last, the next one goes after them.
+    vector<Real> ring(frames * 12, 0.0);
+    int kept = std::min(frames, _windowFrames);
+    for (int f=0; f<kept; f++){
+        int from = (_ringIndex - kept + f + _windowFrames) % _windowFrames;
+        std::copy(_ring.begin() + from * 12, _ring.begin() + (from + 1) * 12, ring.begin() + f * 12);
+    }
+    _ring.swap(ring);
+    _windowFrames = frames;
+    _ringIndex = kept % frames;
+    resum();
+}
+//-------------------------------------------
+void ofxAAChordsAlgorithm::resum(){
+    for (int i=0; i<12; i++){ _sum[i] = 0.0; }
+    for (int f=0; f<_windowFrames; f++){
+        for (int i=0; i<12; i++){ _sum[i] += _ring[f*12 + i]; }
+    }
+}
+//-------------------------------------------
+void ofxAAChordsAlgorithm::resetAlgorithm(){
+    ofxAAOneVectorOutputAlgorithm::resetAlgorithm();
+    setWindowSize(_defaultWindowSize);
+}
+//-------------------------------------------
+void ofxAAChordsAlgorithm::compute(){
+    outputValues[0] = 0.0;
+    outputValues[1] = 0.0;
+    if (!isActive || _hpcp == NULL || _hpcp->size() < 12){ return; }
+    
+    //Swap the oldest frame for the new one in the running sum.
+    Real* slot = _ring.data() + _ringIndex * 12;
+    const Real* hpcp = _hpcp->data();
+    for (int i=0; i<12; i++){
+        _sum[i] += hpcp[i] - slot[i];
+        slot[i] = hpcp[i];
+    }
+    _ringIndex = (_ringIndex + 1) % _windowFrames;
+    //Resum once per window so rounding errors don't build up.
+    if (_ringIndex == 0){
+        resum();
+    }
+    
+    //Correlation with each template: the mean of the window doesn't need dividing by the frames number.
+    Real centered[12];
+    Real norm = ofxaa::centerChroma(_sum, centered);
+    if (norm <= 0.0){ return; }
+    
+    Real bestCorrelation;
+    int bestChord = ofxaa::bestTemplate(centered, _templates, CHORDS_NUMBER, bestCorrelation);
+    outputValues[0] = bestChord;
+    outputValues[1] = std::max((Real)0.0, bestCorrelation / norm);
+}
+//-------------------------------------------
+string ofxAAChordsAlgorithm::chordName(int chordIndex){
+    if (chordIndex < 0 || chordIndex >= CHORDS_NUMBER){ return ""; }
+    string name = ofxaa::pitchClassName(chordIndex);
+    return chordIndex < 12 ? name : name + "m";
+}
+//-------------------------------------------
+string ofxAAChordsAlgorithm::getChordName(){
+    if (outputValues[1] <= 0.0){ return ""; }
+    return chordName(int(outputValues[0]));
+}
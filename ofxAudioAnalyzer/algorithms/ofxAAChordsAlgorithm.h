@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#pragma once
+
+#include "ofxAAOneVectorOutputAlgorithm.h"
+
+#define CHORDS_WINDOW_SIZE 2.0 //seconds, Essentia ChordsDetection default
+#define CHORDS_NUMBER 24
+
+///Chord of the HPCP averaged over the last windowSize seconds, as Essentia's ChordsDetection.
+///The last frames are kept in a ring with a running sum, so each frame costs one update of the sum
+///and a correlation with the 24 major/minor triad templates.
+///outputValues[0] is the chord index (0-11 major, 12-23 minor, roots from A), outputValues[1] its strength.
+class ofxAAChordsAlgorithm : public ofxAAOneVectorOutputAlgorithm {
+public:
+    
+    ofxAAChordsAlgorithm(int samplerate, int framesize, Real windowSize = CHORDS_WINDOW_SIZE);
+    
+    void compute() override;
+    
+    ///12 bins HPCP, index 0 on A.
+    void setHpcpInput(vector<Real>& hpcp){ _hpcp = &hpcp; }
+    
+    ///Length of the averaging window in seconds. Clears the window.
+    void setWindowSize(Real windowSize);
+    ///Seconds between frames, bufferSize/sampleRate until set. Keeps the newest frames of the window.
+    void setFramePeriod(Real seconds);
+    ///Back to the window size it was built with, with an empty window.
+    void resetAlgorithm() override;
+    
+    ///"A", "Bbm", ... of the last detected chord, empty when there is none.
+    string getChordName();
+    static string chordName(int chordIndex);
+    
+private:
+    void buildTemplates();
+    ///Sum of the window from the ring.
+    void resum();
+    
+    vector<Real>* _hpcp;
+    
+    Real _framePeriod;
+    
+    vector<Real> _ring;///windowFrames x 12
+    int _windowFrames;
+    Real _windowSize;
+    Real _defaultWindowSize;
+    int _ringIndex;
+    Real _sum[12];
+    
+    ///Zero mean, unit norm templates, so the correlation is a dot product.
+    Real _templates[CHORDS_NUMBER][12];
+    
+};
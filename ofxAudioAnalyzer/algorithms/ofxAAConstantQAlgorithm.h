@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#pragma once
+
+#include "ofxAAOneVectorOutputAlgorithm.h"
+#include "ofxAAConstantQ.h"
+
+#define CONSTANT_Q_BINS_PER_OCTAVE 12
+#define CONSTANT_Q_MIN_FREQUENCY 65.406 //C2
+#define CONSTANT_Q_BINS_NUMBER 84 //7 octaves
+
+///Constant-Q magnitudes of the shared FFT, from a shared ofxaa::ConstantQKernel.
+class ofxAAConstantQAlgorithm : public ofxAAOneVectorOutputAlgorithm {
+public:
+    
+    ofxAAConstantQAlgorithm(int samplerate, int framesize, int binsPerOctave = CONSTANT_Q_BINS_PER_OCTAVE, Real minFrequency = CONSTANT_Q_MIN_FREQUENCY, int binsNum = CONSTANT_Q_BINS_NUMBER);
+    
+    void compute() override;
+    
+    void setFftInput(vector< complex<Real> >& fftValues){ _fftValues = &fftValues; }
+    
+    const vector<Real>& getCenterFrequencies(){ return _kernel->centerFrequencies; }
+    
+private:
+    std::shared_ptr<const ofxaa::ConstantQKernel> _kernel;
+    vector< complex<Real> >* _fftValues;
+    
+};
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#include "ofxAADissonanceAlgorithm.h"
+
+#define PLOMP_LEVELT_MAX_DISTANCE 1.18 //critical bands
+#define PLOMP_LEVELT_TABLE_SIZE 1024
+
+namespace {
+    
+    ///Consonance of two tones df critical bands apart (Essentia's Dissonance polynomial fit).
+    Real plompLevelt(Real df){
+        if (df < 0 || df > PLOMP_LEVELT_MAX_DISTANCE){ return 1.0; }
+        Real c = -6.58977878 * pow(df, 5) + 28.58224226 * pow(df, 4) - 47.36739986 * pow(df, 3)
+                 + 35.70679761 * df * df - 10.36526344 * df + 1.00026609;
+        return std::max((Real)0.0, std::min((Real)1.0, c));
+    }
+    
+    ///Dissonance (1 - consonance) sampled over [0, 1.18] critical bands, shared by every instance.
+    const vector<Real>& plompLeveltTable(){
+        static const vector<Real> table = [](){
+            vector<Real> t(PLOMP_LEVELT_TABLE_SIZE + 1);
+            for (size_t i=0; i<t.size(); i++){
+                t[i] = 1.0 - plompLevelt(PLOMP_LEVELT_MAX_DISTANCE * i / PLOMP_LEVELT_TABLE_SIZE);
+            }
+            return t;
+        }();
+        return table;
+    }
+    
+    inline Real tableDissonance(const Real* table, Real df){
+        Real position = df * (PLOMP_LEVELT_TABLE_SIZE / PLOMP_LEVELT_MAX_DISTANCE);
+        if (position >= PLOMP_LEVELT_TABLE_SIZE){ return 0.0; }
+        int i = int(position);
+        Real fraction = position - i;
+        return table[i] + fraction * (table[i+1] - table[i]);
+    }
+    
+    ///A-weighting as a linear gain
+    Real aWeighting(Real f){
+        Real f2 = f * f;
+        Real ra = (12194.0 * 12194.0 * f2 * f2) /
+                  ((f2 + 20.6 * 20.6) * sqrt((f2 + 107.7 * 107.7) * (f2 + 737.9 * 737.9)) * (f2 + 12194.0 * 12194.0));
+        return ra * 1.2589; //+2dB: unity gain at 1kHz
+    }
+}
+
+ofxAADissonanceAlgorithm::ofxAADissonanceAlgorithm(int samplerate, int framesize, int maxPeaks, Real minContribution) : ofxAASingleOutputAlgorithm(ofxaa::BoundedDissonance, samplerate, framesize) {
+    _frequencies = NULL;
+    _magnitudes = NULL;
+    _minContribution = minContribution;
+    setMaxPeaks(maxPeaks);
+    plompLeveltTable();
+}
+//-------------------------------------------
+void ofxAADissonanceAlgorithm::setMaxPeaks(int maxPeaks){
+    _maxPeaks = std::max(maxPeaks, 2);
+    _order.reserve(_maxPeaks * 4);
+    _peakFrequencies.reserve(_maxPeaks);
+    _loudness.reserve(_maxPeaks);
+    _bandwidths.reserve(_maxPeaks);
+}
+//-------------------------------------------
+void ofxAADissonanceAlgorithm::setPeaksInput(vector<Real>& frequencies, vector<Real>& magnitudes){
+    _frequencies = &frequencies;
+    _magnitudes = &magnitudes;
+}
+//-------------------------------------------
+void ofxAADissonanceAlgorithm::selectPeaks(){
+    const vector<Real>& frequencies = *_frequencies;
+    const vector<Real>& magnitudes = *_magnitudes;
+    int size = std::min(frequencies.size(), magnitudes.size());
+    
+    _order.resize(size);
+    for (int i=0; i<size; i++){ _order[i] = i; }
+    //Keep the strongest peaks, back in frequency order.
+    if (size > _maxPeaks){
+        std::nth_element(_order.begin(), _order.begin() + _maxPeaks, _order.end(), [&magnitudes](int a, int b){
+            return magnitudes[a] > magnitudes[b];
+        });
+        _order.resize(_maxPeaks);
+        std::sort(_order.begin(), _order.end());
+    }
+    
+    _peakFrequencies.clear();
+    _loudness.clear();
+    _bandwidths.clear();
+    for (int i : _order){
+        Real f = frequencies[i];
+        _peakFrequencies.push_back(f);
+        _loudness.push_back(magnitudes[i] * aWeighting(f));
+        _bandwidths.push_back(barkCriticalBandwidth(hz2bark(f)));
+    }
+}
+//-------------------------------------------
+void ofxAADissonanceAlgorithm::compute(){
+    outputValue = 0.0;
+    if (!isActive || _frequencies == NULL || _magnitudes == NULL){ return; }
+    if (_frequencies->size() < 2){ return; }
+    
+    selectPeaks();
+    int size = (int)_peakFrequencies.size();
+    
+    Real totalLoudness = 0.0;
+    for (Real l : _loudness){ totalLoudness += l; }
+    if (totalLoudness <= 0.0){ return; }
+    for (Real& l : _loudness){ l /= totalLoudness; }
+    
+    const Real* table = plompLeveltTable().data();
+    const Real* f = _peakFrequencies.data();
+    const Real* loudness = _loudness.data();
+    const Real* bandwidth = _bandwidths.data();
+    
+    double dissonance = 0.0;
+    for (int p1=0; p1<size; p1++){
+        //A pair adds at most the quieter loudness.
+        if (f[p1] <= 50.0 || loudness[p1] < _minContribution){ continue; }
+        Real exitFrequency = bark2hz(hz2bark(f[p1]) + PLOMP_LEVELT_MAX_DISTANCE);
+        for (int p2=p1+1; p2<size && f[p2] < exitFrequency; p2++){
+            Real weight = std::min(loudness[p1], loudness[p2]);
+            if (weight < _minContribution){ continue; }
+            Real df = fabs(f[p2] - f[p1]) / std::min(bandwidth[p1], bandwidth[p2]);
+            Real d = tableDissonance(table, df) * weight;
+            if (d > 0.0){ dissonance += d; }
+        }
+    }
+    outputValue = std::max(0.0, std::min(1.0, dissonance));
+}
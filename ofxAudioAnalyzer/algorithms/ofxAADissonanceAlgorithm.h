@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#pragma once
+
+#include "ofxAASingleOutputAlgorithm.h"
+
+#define DISSONANCE_MAX_PEAKS 40
+#define DISSONANCE_MIN_CONTRIBUTION 1e-5
+
+///Sensory dissonance of frequency-ordered spectral peaks, as Essentia's Dissonance
+///(Plomp-Levelt roughness of peak pairs within 1.18 critical bands, weighted by A-weighted loudness).
+///Cost is bounded: only the strongest maxPeaks peaks are used, the Plomp-Levelt curve is a shared
+///lookup table, and peaks or pairs that can't add more than minContribution are skipped.
+class ofxAADissonanceAlgorithm : public ofxAASingleOutputAlgorithm {
+public:
+    
+    ofxAADissonanceAlgorithm(int samplerate, int framesize, int maxPeaks = DISSONANCE_MAX_PEAKS, Real minContribution = DISSONANCE_MIN_CONTRIBUTION);
+    
+    void compute() override;
+    
+    void setPeaksInput(vector<Real>& frequencies, vector<Real>& magnitudes);
+    
+    void setMaxPeaks(int maxPeaks);
+    int getMaxPeaks(){ return _maxPeaks; }
+    
+private:
+    void selectPeaks();
+    
+    vector<Real>* _frequencies;
+    vector<Real>* _magnitudes;
+    
+    int _maxPeaks;
+    Real _minContribution;
+    
+    ///Scratch, sized for maxPeaks
+    vector<int> _order;
+    vector<Real> _peakFrequencies;
+    vector<Real> _loudness;
+    vector<Real> _bandwidths;
+    
+};
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#include "ofxAAEnergyBandAlgorithm.h"
+
+ofxAAEnergyBandAlgorithm::ofxAAEnergyBandAlgorithm(int samplerate, int framesize, Real startFrequency, Real stopFrequency) : ofxAASingleOutputAlgorithm(ofxaa::PowerEnergyBand, samplerate, framesize) {
+    _energyIndex = NULL;
+    _startFrequency = startFrequency;
+    _stopFrequency = stopFrequency;
+    
+    Real nyquist = samplerate / 2.0;
+    int lastBin = framesize / 2;
+    _startBin = int(round(startFrequency / nyquist * lastBin));
+    _stopBin = int(round(stopFrequency / nyquist * lastBin));
+    _startBin = std::max(0, std::min(_startBin, lastBin));
+    _stopBin = std::max(0, std::min(_stopBin, lastBin));
+    if (_startBin > _stopBin){
+        cout << "ofxAAEnergyBandAlgorithm: start frequency higher than stop frequency" << endl;
+        _stopBin = _startBin;
+    }
+}
+//-------------------------------------------
+void ofxAAEnergyBandAlgorithm::compute(){
+    if (!isActive || _energyIndex == NULL){
+        outputValue = 0.0;
+        return;
+    }
+    outputValue = _energyIndex->getBandEnergy(_startBin, _stopBin);
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#pragma once
+
+#include "ofxAASingleOutputAlgorithm.h"
+#include "ofxAAEnergyIndexAlgorithm.h"
+
+///Energy of a frequency band, read from the cumulative energy index in constant time.
+///Same bin selection as Essentia's EnergyBand.
+///A band from 0 to samplerate/2 gives the total spectral energy (Essentia's Energy).
+class ofxAAEnergyBandAlgorithm : public ofxAASingleOutputAlgorithm {
+public:
+    
+    ofxAAEnergyBandAlgorithm(int samplerate, int framesize, Real startFrequency, Real stopFrequency);
+    
+    void compute() override;
+    
+    void setEnergyIndexInput(ofxAAEnergyIndexAlgorithm* energyIndex){ _energyIndex = energyIndex; }
+    
+    Real getStartFrequency(){ return _startFrequency; }
+    Real getStopFrequency(){ return _stopFrequency; }
+    
+private:
+    ofxAAEnergyIndexAlgorithm* _energyIndex;
+    
+    Real _startFrequency;
+    Real _stopFrequency;
+    int _startBin;
+    int _stopBin;///inclusive
+    
+};
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#include "ofxAAEnergyBandsAlgorithm.h"
+
+#include <sstream>
+
+ofxAAEnergyBandsAlgorithm::ofxAAEnergyBandsAlgorithm(int samplerate, int framesize) : ofxAAOneVectorOutputAlgorithm(ofxaa::PowerEnergyBands, samplerate, framesize) {
+    _samplerate = samplerate;
+    _framesize = framesize;
+    _powerSpectrum = NULL;
+    _energyIndex = NULL;
+    setBandsPerOctave(1);
+}
+//-------------------------------------------
+void ofxAAEnergyBandsAlgorithm::resetAlgorithm(){
+    ofxAAOneVectorOutputAlgorithm::resetAlgorithm();
+    setBandsPerOctave(1);
+}
+//-------------------------------------------
+void ofxAAEnergyBandsAlgorithm::setInputs(vector<Real>& powerSpectrum, ofxAAEnergyIndexAlgorithm* energyIndex){
+    _powerSpectrum = &powerSpectrum;
+    _energyIndex = energyIndex;
+}
+//-------------------------------------------
+void ofxAAEnergyBandsAlgorithm::setBandsPerOctave(int bandsPerOctave){
+    setBandEdges(fractionalOctaveEdges(bandsPerOctave));
+}
+//-------------------------------------------
+void ofxAAEnergyBandsAlgorithm::setBandEdges(const vector<Real>& edges){
+    if (edges == _edges){ return; }
+    if (edges.size() < 2){
+        cout << "ofxAAEnergyBandsAlgorithm: at least two band edges are needed" << endl;
+        return;
+    }
+    for (size_t i=1; i<edges.size(); i++){
+        if (edges[i] <= edges[i-1]){
+            cout << "ofxAAEnergyBandsAlgorithm: band edges must be ascending" << endl;
+            return;
+        }
+    }
+    _edges = edges;
+    updateBands();
+}
+//-------------------------------------------
+void ofxAAEnergyBandsAlgorithm::updateBands(){
+    //Bin k covers [k-0.5, k+0.5] in bin units. Boundary bins are weighted by their overlap with the band,
+    //so adjacent bands share the energy of a common bin instead of counting it twice.
+    Real binWidth = (_samplerate / 2.0) / (_framesize / 2);
+    int lastBin = _framesize / 2;
+    Real binsMax = lastBin + 0.5;
+    
+    _bands.resize(_edges.size() - 1);
+    for (size_t i=0; i<_bands.size(); i++){
+        Band& band = _bands[i];
+        Real a = std::max((Real)-0.5, _edges[i] / binWidth);
+        Real b = std::min(binsMax, _edges[i+1] / binWidth);
+        band.isEmpty = (a >= b);
+        if (band.isEmpty){
+            band.lowBin = band.highBin = 0;
+            band.lowWeight = band.highWeight = 0.0;
+            continue;
+        }
+        band.lowBin = std::min(int(floor(a + 0.5)), lastBin);
+        band.highBin = std::min(int(floor(b + 0.5)), lastBin);
+        if (band.lowBin == band.highBin){
+            band.lowWeight = b - a;
+            band.highWeight = 0.0;
+        } else {
+            band.lowWeight = (band.lowBin + 0.5) - a;
+            band.highWeight = b - (band.highBin - 0.5);
+        }
+    }
+    assignOutputValuesSize((int)_bands.size(), 0.0);
+}
+//-------------------------------------------
+void ofxAAEnergyBandsAlgorithm::compute(){
+    if (!isActive || _powerSpectrum == NULL || _energyIndex == NULL){
+        std::fill(outputValues.begin(), outputValues.end(), 0.0);
+        return;
+    }
+    
+    const Real* power = _powerSpectrum->data();
+    for (size_t i=0; i<_bands.size(); i++){
+        const Band& band = _bands[i];
+        if (band.isEmpty){
+            outputValues[i] = 0.0;
+            continue;
+        }
+        double energy = band.lowWeight * power[band.lowBin];
+        if (band.highBin > band.lowBin){
+            energy += band.highWeight * power[band.highBin];
+            energy += _energyIndex->getBandEnergy(band.lowBin + 1, band.highBin - 1);
+        }
+        outputValues[i] = energy;
+    }
+}
+//-------------------------------------------
+vector<Real> ofxAAEnergyBandsAlgorithm::fractionalOctaveEdges(int bandsPerOctave){
+    int b = std::max(bandsPerOctave, 1);
+    //Centres within a sixth of an octave of the nominal limits, so 20Hz and 20kHz bands are kept.
+    Real tolerance = pow(2.0, 1.0/6.0);
+    int kMin = int(ceil(b * log2(ENERGY_BANDS_MIN_FREQUENCY / tolerance / 1000.0)));
+    int kMax = int(floor(b * log2(ENERGY_BANDS_MAX_FREQUENCY * tolerance / 1000.0)));
+    
+    vector<Real> edges;
+    for (int k=kMin; k<=kMax+1; k++){
+        edges.push_back(1000.0 * pow(2.0, (k - 0.5) / b));
+    }
+    return edges;
+}
+//-------------------------------------------
+vector<Real> ofxAAEnergyBandsAlgorithm::parseBandEdges(const string& edges){
+    string s = edges;
+    std::replace(s.begin(), s.end(), ',', ' ');
+    std::istringstream stream(s);
+    vector<Real> result;
+    Real value;
+    while (stream >> value){
+        if (!result.empty() && value <= result.back()){
+            return vector<Real>();
+        }
+        result.push_back(value);
+    }
+    return result;
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#pragma once
+
+#include "ofxAAOneVectorOutputAlgorithm.h"
+#include "ofxAAEnergyIndexAlgorithm.h"
+
+#define ENERGY_BANDS_MIN_FREQUENCY 20.0
+#define ENERGY_BANDS_MAX_FREQUENCY 20000.0
+
+///Energy of any number of contiguous frequency bands, output as one vector.
+///Bin ranges and partial-bin weights are computed when the band edges change,
+///so each frame costs two weighted bins plus one energy index lookup per band.
+///The output size follows the bands number, so it stays out of the Network arena.
+class ofxAAEnergyBandsAlgorithm : public ofxAAOneVectorOutputAlgorithm {
+public:
+    
+    ///Starts with octave bands.
+    ofxAAEnergyBandsAlgorithm(int samplerate, int framesize);
+    
+    void compute() override;
+    
+    void reserveBuffers(ofxaa::Arena&) override {}
+    
+    void setInputs(vector<Real>& powerSpectrum, ofxAAEnergyIndexAlgorithm* energyIndex);
+    
+    ///Sets bands from ascending edges in Hz: N+1 edges make N bands.
+    void setBandEdges(const vector<Real>& edges);
+    ///Sets 1/bandsPerOctave octave bands (1: octave, 3: third octave).
+    void setBandsPerOctave(int bandsPerOctave);
+    ///Back to octave bands.
+    void resetAlgorithm() override;
+    
+    const vector<Real>& getBandEdges() const { return _edges; }
+    int getBandsNum() const { return (int)_bands.size(); }
+    
+    ///Base-two fractional octave edges, centred on 1kHz, for centres from 20Hz to 20kHz.
+    static vector<Real> fractionalOctaveEdges(int bandsPerOctave);
+    ///Parses edges in Hz separated by spaces or commas. Returns an empty vector if not ascending.
+    static vector<Real> parseBandEdges(const string& edges);
+    
+private:
+    struct Band {
+        int lowBin;
+        Real lowWeight;
+        int highBin;
+        Real highWeight;
+        bool isEmpty;
+    };
+    
+    void updateBands();
+    
+    vector<Real>* _powerSpectrum;
+    ofxAAEnergyIndexAlgorithm* _energyIndex;
+    
+    vector<Real> _edges;
+    vector<Band> _bands;
+    
+    int _samplerate;
+    int _framesize;
+    
+};
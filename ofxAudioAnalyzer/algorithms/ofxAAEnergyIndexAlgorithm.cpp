@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#include "ofxAAEnergyIndexAlgorithm.h"
+
+ofxAAEnergyIndexAlgorithm::ofxAAEnergyIndexAlgorithm(int samplerate, int framesize) : ofxAABaseAlgorithm(ofxaa::PowerEnergyIndex, samplerate, framesize) {
+    _powerSpectrum = NULL;
+    _cumulative.assign((framesize/2)+2, 0.0);
+    _binWidth = (samplerate / 2.0) / (framesize / 2);
+}
+//-------------------------------------------
+void ofxAAEnergyIndexAlgorithm::reserveBuffers(ofxaa::Arena& arena){
+    arena.reserve(_cumulative);
+}
+//-------------------------------------------
+void ofxAAEnergyIndexAlgorithm::compute(){
+    if (!isActive || _powerSpectrum == NULL){
+        std::fill(_cumulative.begin(), _cumulative.end(), 0.0);
+        return;
+    }
+    
+    const Real* power = _powerSpectrum->data();
+    double* cumulative = _cumulative.data();
+    int size = std::min(_powerSpectrum->size(), _cumulative.size() - 1);
+    
+    double sum = 0.0;
+    cumulative[0] = 0.0;
+    for (int i=0; i<size; i++){
+        sum += power[i];
+        cumulative[i+1] = sum;
+    }
+}
+//-------------------------------------------
+double ofxAAEnergyIndexAlgorithm::getBandEnergy(int startBin, int stopBin) const {
+    int lastBin = getBinsNum() - 1;
+    startBin = std::max(startBin, 0);
+    stopBin = std::min(stopBin, lastBin);
+    if (startBin > stopBin){ return 0.0; }
+    return _cumulative[stopBin+1] - _cumulative[startBin];
+}
+//-------------------------------------------
+int ofxAAEnergyIndexAlgorithm::getCumulativeBin(double energy) const {
+    auto first = _cumulative.begin() + 1;
+    auto it = std::lower_bound(first, _cumulative.end(), energy);
+    if (it == _cumulative.end()){ return getBinsNum() - 1; }
+    return (int)(it - first);
+}
+//-------------------------------------------
+int ofxAAEnergyIndexAlgorithm::getBinForFrequency(Real frequency) const {
+    int bin = int(round(frequency / _binWidth));
+    return std::max(0, std::min(bin, getBinsNum() - 1));
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#pragma once
+
+#include "ofxAABaseAlgorithm.h"
+
+///Cumulative power of the spectrum, computed once per frame.
+///Any band energy is the difference of two entries and the roll-off
+///frequency a binary search, so energy descriptors never rescan the spectrum.
+class ofxAAEnergyIndexAlgorithm : public ofxAABaseAlgorithm {
+public:
+    
+    ofxAAEnergyIndexAlgorithm(int samplerate, int framesize);
+    
+    void compute() override;
+    
+    void reserveBuffers(ofxaa::Arena& arena) override;
+    
+    size_t getOutputBytes() override { return _cumulative.size() * sizeof(double); }
+    
+    void setPowerSpectrumInput(vector<Real>& powerSpectrum){ _powerSpectrum = &powerSpectrum; }
+    
+    ///Energy of bins startBin to stopBin, both inclusive.
+    double getBandEnergy(int startBin, int stopBin) const;
+    double getTotalEnergy() const { return _cumulative.back(); }
+    
+    ///Lowest bin at which the cumulative energy reaches energy.
+    int getCumulativeBin(double energy) const;
+    
+    ///Nearest spectrum bin for a frequency, clamped to the spectrum.
+    int getBinForFrequency(Real frequency) const;
+    Real getFrequencyForBin(int bin) const { return bin * _binWidth; }
+    
+    int getBinsNum() const { return (int)_cumulative.size() - 1; }
+    
+private:
+    vector<Real>* _powerSpectrum;
+    
+    ///_cumulative[i] holds the energy of bins 0 to i-1, _cumulative[0] is 0.
+    ofxaa::ArenaVector<double> _cumulative;
+    
+    Real _binWidth;
+    
+};
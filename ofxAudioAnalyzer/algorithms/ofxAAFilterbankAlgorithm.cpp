@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#include "ofxAAFilterbankAlgorithm.h"
+
+ofxAAFilterbankAlgorithm::ofxAAFilterbankAlgorithm(ofxaa::FilterbankType filterbankType, int bandsNum, int samplerate, int framesize) : ofxAAOneVectorOutputAlgorithm(ofxaa::Filterbank, samplerate, framesize) {
+    _powerSpectrum = NULL;
+    _table = ofxaa::getFilterbankTable(filterbankType, bandsNum, samplerate, framesize);
+    assignOutputValuesSize(_table->bandsNum, 0.0);
+}
+//-------------------------------------------
+void ofxAAFilterbankAlgorithm::compute(){
+    if (!isActive || _powerSpectrum == NULL || (int)_powerSpectrum->size() < _table->getSpectrumSize()){
+        std::fill(outputValues.begin(), outputValues.end(), 0.0);
+        return;
+    }
+    _table->apply(_powerSpectrum->data(), outputValues.data());
+}
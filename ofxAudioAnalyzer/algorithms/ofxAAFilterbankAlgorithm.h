@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#pragma once
+
+#include "ofxAAOneVectorOutputAlgorithm.h"
+#include "ofxAAFilterbank.h"
+
+///Mel, Bark or ERB bands of the power spectrum, from a shared ofxaa::FilterbankTable.
+class ofxAAFilterbankAlgorithm : public ofxAAOneVectorOutputAlgorithm {
+public:
+    
+    ofxAAFilterbankAlgorithm(ofxaa::FilterbankType filterbankType, int bandsNum, int samplerate, int framesize);
+    
+    void compute() override;
+    
+    void setPowerSpectrumInput(vector<Real>& powerSpectrum){ _powerSpectrum = &powerSpectrum; }
+    
+    const vector<Real>& getCenterFrequencies(){ return _table->centerFrequencies; }
+    
+private:
+    std::shared_ptr<const ofxaa::FilterbankTable> _table;
+    vector<Real>* _powerSpectrum;
+    
+};
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#include "ofxAAHarmonicDescriptorsAlgorithm.h"
+
+ofxAAHarmonicDescriptorsAlgorithm::ofxAAHarmonicDescriptorsAlgorithm(int samplerate, int framesize) : ofxAABaseAlgorithm(ofxaa::HarmonicDescriptors, samplerate, framesize) {
+    _frequencies = NULL;
+    _magnitudes = NULL;
+    
+    inharmonicity = new ofxAASingleOutputAlgorithm(ofxaa::HarmonicDescriptors, samplerate, framesize);
+    oddToEven = new ofxAASingleOutputAlgorithm(ofxaa::HarmonicDescriptors, samplerate, framesize);
+    tristimulus = new ofxAAOneVectorOutputAlgorithm(ofxaa::HarmonicDescriptors, samplerate, framesize, 3);
+    spectralTilt = new ofxAASingleOutputAlgorithm(ofxaa::HarmonicDescriptors, samplerate, framesize);
+    harmonicEnergy = new ofxAASingleOutputAlgorithm(ofxaa::HarmonicDescriptors, samplerate, framesize);
+}
+//-------------------------------------------
+ofxAAHarmonicDescriptorsAlgorithm::~ofxAAHarmonicDescriptorsAlgorithm(){
+    delete inharmonicity;
+    delete oddToEven;
+    delete tristimulus;
+    delete spectralTilt;
+    delete harmonicEnergy;
+}
+//-------------------------------------------
+void ofxAAHarmonicDescriptorsAlgorithm::setHarmonicPeaksInput(vector<Real>& frequencies, vector<Real>& magnitudes){
+    _frequencies = &frequencies;
+    _magnitudes = &magnitudes;
+}
+//-------------------------------------------
+size_t ofxAAHarmonicDescriptorsAlgorithm::getOutputBytes(){
+    return inharmonicity->getOutputBytes() + oddToEven->getOutputBytes() + tristimulus->getOutputBytes()
+        + spectralTilt->getOutputBytes() + harmonicEnergy->getOutputBytes();
+}
+//-------------------------------------------
+void ofxAAHarmonicDescriptorsAlgorithm::reserveBuffers(ofxaa::Arena& arena){
+    tristimulus->reserveBuffers(arena);
+}
+//-------------------------------------------
+void ofxAAHarmonicDescriptorsAlgorithm::saveDefaults(){
+    ofxAABaseAlgorithm::saveDefaults();
+    inharmonicity->saveDefaults();
+    oddToEven->saveDefaults();
+    tristimulus->saveDefaults();
+    spectralTilt->saveDefaults();
+    harmonicEnergy->saveDefaults();
+}
+//-------------------------------------------
+void ofxAAHarmonicDescriptorsAlgorithm::resetAlgorithm(){
+    ofxAABaseAlgorithm::resetAlgorithm();
+    inharmonicity->resetAlgorithm();
+    oddToEven->resetAlgorithm();
+    tristimulus->resetAlgorithm();
+    spectralTilt->resetAlgorithm();
+    harmonicEnergy->resetAlgorithm();
+}
+//-------------------------------------------
+void ofxAAHarmonicDescriptorsAlgorithm::clearOutputs(){
+    inharmonicity->outputValue = 0.0;
+    oddToEven->outputValue = 0.0;
+    std::fill(tristimulus->outputValues.begin(), tristimulus->outputValues.end(), 0.0);
+    spectralTilt->outputValue = 0.0;
+    harmonicEnergy->outputValue = 0.0;
+}
+//-------------------------------------------
+void ofxAAHarmonicDescriptorsAlgorithm::compute(){
+    clearOutputs();
+    if (!isActive || _frequencies == NULL || _magnitudes == NULL){ return; }
+    
+    const Real* f = _frequencies->data();
+    const Real* m = _magnitudes->data();
+    int size = std::min(_frequencies->size(), _magnitudes->size());
+    if (size == 0 || f[0] <= 0.0){ return; }
+    Real f0 = f[0];
+    
+    double energy = 0.0;
+    double oddEnergy = 0.0;
+    double evenEnergy = 0.0;
+    double deviation = 0.0;
+    double magnitudeSum = 0.0;
+    double t1 = 0.0, t2 = 0.0, t3 = 0.0;
+    //Least squares of dB against octaves
+    double sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+    int tiltPoints = 0;
+    
+    for (int i=0; i<size; i++){
+        Real magnitude = m[i];
+        Real e = magnitude * magnitude;
+        energy += e;
+        //Peak indices as Essentia: the fundamental (index 0) counts as even.
+        if (i % 2 == 0){ evenEnergy += e; } else { oddEnergy += e; }
+        
+        Real ratio = round(f[i] / f0);
+        deviation += fabs(f[i] - ratio * f0) * e;
+        
+        magnitudeSum += magnitude;
+        if (i == 0){ t1 += magnitude; } else if (i < 4){ t2 += magnitude; } else { t3 += magnitude; }
+        
+        if (magnitude > 0.0 && f[i] > 0.0){
+            double x = log2(f[i]);
+            double y = 20.0 * log10(magnitude);
+            sx += x; sy += y; sxx += x*x; sxy += x*y;
+            tiltPoints++;
+        }
+    }
+    
+    harmonicEnergy->outputValue = energy;
+    
+    if (energy > 0.0){
+        inharmonicity->outputValue = deviation / (energy * f0);
+    }
+    
+    //Capped when only the odd indices have energy, 0 without energy.
+    if (evenEnergy > 0.0){
+        oddToEven->outputValue = std::min(oddEnergy / evenEnergy, ODD_TO_EVEN_MAX_RATIO);
+    } else if (oddEnergy > 0.0){
+        oddToEven->outputValue = ODD_TO_EVEN_MAX_RATIO;
+    }
+    
+    if (magnitudeSum > 0.0){
+        tristimulus->outputValues[0] = t1 / magnitudeSum;
+        tristimulus->outputValues[1] = t2 / magnitudeSum;
+        tristimulus->outputValues[2] = t3 / magnitudeSum;
+    }
+    
+    double denominator = tiltPoints * sxx - sx * sx;
+    if (tiltPoints > 1 && denominator > 0.0){
+        spectralTilt->outputValue = (tiltPoints * sxy - sx * sy) / denominator;
+    }
+    
+    if (!inharmonicity->isActive){ inharmonicity->outputValue = 0.0; }
+    if (!oddToEven->isActive){ oddToEven->outputValue = 0.0; }
+    if (!tristimulus->isActive){ std::fill(tristimulus->outputValues.begin(), tristimulus->outputValues.end(), 0.0); }
+    if (!spectralTilt->isActive){ spectralTilt->outputValue = 0.0; }
+    if (!harmonicEnergy->isActive){ harmonicEnergy->outputValue = 0.0; }
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#pragma once
+
+#include "ofxAASingleOutputAlgorithm.h"
+#include "ofxAAOneVectorOutputAlgorithm.h"
+
+#define ODD_TO_EVEN_MAX_RATIO 1000.0
+
+///Inharmonicity, OddToEvenHarmonicEnergyRatio, Tristimulus, spectral tilt and harmonic energy
+///computed in one pass over the harmonic peaks (fundamental first).
+///Each descriptor is written to its own output algorithm, so values, normalization and
+///setActive() work as with the Essentia algorithms they replace. The outputs are owned here
+///and are not added to the Network algorithms list.
+class ofxAAHarmonicDescriptorsAlgorithm : public ofxAABaseAlgorithm {
+public:
+    
+    ofxAAHarmonicDescriptorsAlgorithm(int samplerate, int framesize);
+    ~ofxAAHarmonicDescriptorsAlgorithm();
+    
+    void compute() override;
+    
+    void reserveBuffers(ofxaa::Arena& arena) override;
+    
+    size_t getOutputBytes() override;
+    ///Forwarded to the descriptors, which hold the estimated ranges.
+    void saveDefaults() override;
+    void resetAlgorithm() override;
+    
+    void setHarmonicPeaksInput(vector<Real>& frequencies, vector<Real>& magnitudes);
+    
+    ofxAASingleOutputAlgorithm* inharmonicity;
+    ofxAASingleOutputAlgorithm* oddToEven;
+    ofxAAOneVectorOutputAlgorithm* tristimulus;
+    ///Slope of the harmonic magnitudes in dB per octave.
+    ofxAASingleOutputAlgorithm* spectralTilt;
+    ///Sum of the squared harmonic magnitudes.
+    ofxAASingleOutputAlgorithm* harmonicEnergy;
+    
+private:
+    void clearOutputs();
+    
+    vector<Real>* _frequencies;
+    vector<Real>* _magnitudes;
+    
+};
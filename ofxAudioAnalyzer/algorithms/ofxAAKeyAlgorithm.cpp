@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#include "ofxAAKeyAlgorithm.h"
+#include "ofxAAPitchClassTemplates.h"
+
+namespace {
+    const Real krumhanslMajor[] = {6.35, 2.23, 3.48, 2.33, 4.38, 4.09, 2.52, 5.19, 2.39, 3.66, 2.29, 2.88};
+    const Real krumhanslMinor[] = {6.33, 2.68, 3.52, 5.38, 2.60, 3.53, 2.54, 4.75, 3.98, 2.69, 3.34, 3.17};
+}
+
+ofxAAKeyAlgorithm::ofxAAKeyAlgorithm(int samplerate, int framesize, Real timeConstant) : ofxAAOneVectorOutputAlgorithm(ofxaa::RunningKey, samplerate, framesize, 3) {
+    _hpcp = NULL;
+    _framePeriod = Real(framesize) / samplerate;
+    buildProfiles();
+    _defaultTimeConstant = timeConstant;
+    setTimeConstant(timeConstant);
+}
+//-------------------------------------------
+void ofxAAKeyAlgorithm::buildProfiles(){
+    for (int k=0; k<KEYS_NUMBER * 2; k++){
+        const Real* profile = k < KEYS_NUMBER ? krumhanslMajor : krumhanslMinor;
+        int tonic = k % KEYS_NUMBER;
+        Real* p = _keyProfiles[k];
+        for (int i=0; i<12; i++){
+            p[(tonic + i) % 12] = profile[i];
+        }
+        ofxaa::normalizeTemplate(p);
+    }
+}
+//-------------------------------------------
+void ofxAAKeyAlgorithm::setTimeConstant(Real timeConstant){
+    _timeConstant = timeConstant;
+    updateDecay();
+    for (int i=0; i<12; i++){ _profile[i] = 0.0; }
+}
+//-------------------------------------------
+void ofxAAKeyAlgorithm::setFramePeriod(Real seconds){
+    _framePeriod = seconds;
+    updateDecay();
+}
+//-------------------------------------------
+void ofxAAKeyAlgorithm::updateDecay(){
+    _decay = exp(-_framePeriod / std::max(_timeConstant, _framePeriod));
+}
+//-------------------------------------------
+void ofxAAKeyAlgorithm::resetAlgorithm(){
+    ofxAAOneVectorOutputAlgorithm::resetAlgorithm();
+    setTimeConstant(_defaultTimeConstant);
+}
+//-------------------------------------------
+void ofxAAKeyAlgorithm::compute(){
+    outputValues[0] = 0.0;
+    outputValues[1] = 0.0;
+    outputValues[2] = 0.0;
+    if (!isActive || _hpcp == NULL || _hpcp->size() < 12){ return; }
+    
+    const Real* hpcp = _hpcp->data();
+    for (int i=0; i<12; i++){
+        _profile[i] = _decay * _profile[i] + hpcp[i];
+    }
+    
+    Real centered[12];
+    Real norm = ofxaa::centerChroma(_profile, centered);
+    if (norm <= 0.0){ return; }
+    
+    Real bestCorrelation;
+    int bestKey = ofxaa::bestTemplate(centered, _keyProfiles, KEYS_NUMBER * 2, bestCorrelation);
+    outputValues[0] = bestKey % KEYS_NUMBER;
+    outputValues[1] = bestKey < KEYS_NUMBER ? 0.0 : 1.0;
+    outputValues[2] = std::max((Real)0.0, bestCorrelation / norm);
+}
+//-------------------------------------------
+string ofxAAKeyAlgorithm::getKeyName(){
+    if (outputValues[2] <= 0.0){ return ""; }
+    string name = ofxaa::pitchClassName(int(outputValues[0]));
+    return outputValues[1] == 0.0 ? name + " major" : name + " minor";
+}
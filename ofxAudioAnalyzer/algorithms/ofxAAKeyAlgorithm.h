@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#pragma once
+
+#include "ofxAAOneVectorOutputAlgorithm.h"
+
+#define KEY_TIME_CONSTANT 20.0 //seconds
+#define KEYS_NUMBER 12
+
+///Key and mode of an exponentially decayed HPCP profile, correlated with Krumhansl's key profiles
+///(Essentia's Key "krumhansl" profile type). Constant time and memory per frame.
+///outputValues[0] is the tonic (0-11, from A), outputValues[1] the mode (0 major, 1 minor), outputValues[2] the strength.
+class ofxAAKeyAlgorithm : public ofxAAOneVectorOutputAlgorithm {
+public:
+    
+    ofxAAKeyAlgorithm(int samplerate, int framesize, Real timeConstant = KEY_TIME_CONSTANT);
+    
+    void compute() override;
+    
+    ///12 bins HPCP, index 0 on A.
+    void setHpcpInput(vector<Real>& hpcp){ _hpcp = &hpcp; }
+    
+    ///Seconds for a frame's weight in the profile to decay to 1/e. Clears the profile.
+    void setTimeConstant(Real timeConstant);
+    ///Seconds between frames, bufferSize/sampleRate until set. Keeps the profile.
+    void setFramePeriod(Real seconds);
+    ///Back to the time constant it was built with, with an empty profile.
+    void resetAlgorithm() override;
+    
+    ///"A major", "C minor", ... of the last estimation, empty when there is none.
+    string getKeyName();
+    
+private:
+    void buildProfiles();
+    void updateDecay();
+    
+    vector<Real>* _hpcp;
+    
+    Real _framePeriod;
+    
+    Real _decay;
+    Real _timeConstant;
+    Real _defaultTimeConstant;
+    Real _profile[12];
+    
+    ///Zero mean, unit norm key profiles rotated to each tonic, major then minor.
+    Real _keyProfiles[KEYS_NUMBER * 2][12];
+    
+};
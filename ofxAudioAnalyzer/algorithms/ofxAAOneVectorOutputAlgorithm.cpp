@@ -47,15 +47,41 @@ void ofxAAOneVectorOutputAlgorithm::checkInternalValuesSizes(){
     }
 }
 //-------------------------------------------
+void ofxAAOneVectorOutputAlgorithm::reserveBuffers(ofxaa::Arena& arena){
+    //Outputs built without a size are resized by Essentia on every compute, they stay on the heap.
+    if (outputValues.empty()){ return; }
+    arena.reserve(_outputBuffer);
+    arena.reserve(_normalizedValues);
+    arena.reserve(_linearValues);
+    arena.reserve(_smoothedValues);
+    arena.reserve(_smoothedValuesNormalized);
+}
+//-------------------------------------------
 void ofxAAOneVectorOutputAlgorithm::compute(){
     ofxAABaseAlgorithm::compute();
     if (!isActive) {
+        //Filled in place: arena buffers can't be reassigned with a different size.
         float zeroValue = hasLogarithmicValues ? dbSilenceCutoff : 0.0;
-        static vector<float> zerosVec(outputValues.size(), zeroValue);
-        outputValues = zerosVec;
+        std::fill(outputValues.begin(), outputValues.end(), zeroValue);
     }
 }
 //-------------------------------------------
+void ofxAAOneVectorOutputAlgorithm::saveDefaults(){
+    ofxAABaseAlgorithm::saveDefaults();
+    _defaultMinEstimatedValues = _minEstimatedValues;
+    _defaultMaxEstimatedValues = _maxEstimatedValues;
+}
+//-------------------------------------------
+void ofxAAOneVectorOutputAlgorithm::resetAlgorithm(){
+    ofxAABaseAlgorithm::resetAlgorithm();
+    _minEstimatedValues = _defaultMinEstimatedValues;
+    _maxEstimatedValues = _defaultMaxEstimatedValues;
+    //Cleared in place, arena buffers keep their size.
+    std::fill(outputValues.begin(), outputValues.end(), 0.0);
+    std::fill(_smoothedValues.begin(), _smoothedValues.end(), 0.0);
+    std::fill(_smoothedValuesNormalized.begin(), _smoothedValuesNormalized.end(), 0.0);
+}
+//-------------------------------------------
 float ofxAAOneVectorOutputAlgorithm::getValueAtIndex(int index, float smooth, bool normalized){
     return getValues(smooth, normalized)[index];
 }
@@ -39,25 +39,26 @@ public:
     void compute() override;
     //void updateLogRealValues();
     
-    //This is only used for chordDetection at the moment...
-    vector<vector<Real>> realsVec;
-    vector<vector<Real>>& realValuesAsVec(){
-        realsVec = {outputValues};
-        return realsVec;
-    }
-    
     float getValueAtIndex(int index, float smooth, bool normalized);
     
     //int getBinsNum();
     vector<float>& getValues(float smooth, bool normalized);
     
-    vector<Real> outputValues;
+    ///Bound to Essentia outputs. Placed in the Network arena when it has a fixed size.
+    vector<Real>& outputValues = _outputBuffer;
+    
+    void reserveBuffers(ofxaa::Arena& arena) override;
+    
+    size_t getOutputBytes() override { return outputValues.size() * sizeof(Real); }
     
     void setMinEstimatedValues(vector<float> values);
     void setMaxEstimatedValues(vector<float> values);
     
     vector<float>& getMinEstimatedValues(){ return _minEstimatedValues; }
     vector<float>& getMaxEstimatedValues(){ return _maxEstimatedValues; };
+    
+    void saveDefaults() override;
+    void resetAlgorithm() override;
     //vector<Real> logRealValues;
     
 protected:
@@ -67,15 +68,20 @@ protected:
     void linValues(vector<float>& valuesToLin, vector<float>& linearValues);
     void smoothValues(vector<float>& valuesToSmooth, vector<float>& smoothedValues, float smthAmnt);
     
-private:
     virtual void assignOutputValuesSize(int size, int val);
     
-    vector<float> _normalizedValues;
-    vector<float> _linearValues;
-    vector<float> _smoothedValues;
-    vector<float> _smoothedValuesNormalized;
+private:
+    
+    ofxaa::ArenaVector<Real> _outputBuffer;
+    
+    ofxaa::ArenaVector<float> _normalizedValues;
+    ofxaa::ArenaVector<float> _linearValues;
+    ofxaa::ArenaVector<float> _smoothedValues;
+    ofxaa::ArenaVector<float> _smoothedValuesNormalized;
     
     vector<float> _minEstimatedValues;
     vector<float> _maxEstimatedValues;
+    vector<float> _defaultMinEstimatedValues;
+    vector<float> _defaultMaxEstimatedValues;
     
 };
@@ -27,13 +27,11 @@
 
 #define ONSETS_DETECTIONS_BUFFER_SIZE 32 //64
 
-ofxAAOnsetsAlgorithm::ofxAAOnsetsAlgorithm(ofxAAOneVectorOutputAlgorithm* windowingAlgorithm, int samplerate, int framesize) : ofxAABaseAlgorithm(ofxaa::Onsets, samplerate, framesize) {
+ofxAAOnsetsAlgorithm::ofxAAOnsetsAlgorithm(ofxAAVectorComplexOutputAlgorithm* fftAlgorithm, int samplerate, int framesize) : ofxAABaseAlgorithm(ofxaa::Onsets, samplerate, framesize) {
     
-    windowing = windowingAlgorithm;
+    fft = fftAlgorithm;
     
-    fft = new ofxAAVectorComplexOutputAlgorithm(ofxaa::Fft, samplerate, framesize);
-    
-    cartesianToPolar = new ofxAATwoVectorsOutputAlgorithm(ofxaa::CartesianToPolar, samplerate, framesize);
+    cartesianToPolar = new ofxAATwoVectorsOutputAlgorithm(ofxaa::CartesianToPolar, samplerate, framesize, (framesize/2)+1, (framesize/2)+1);
     
     onsetHfc = new ofxAASingleOutputAlgorithm(ofxaa::OnsetDetection, samplerate, framesize);
     ofxaa::configureOnsetDetection(onsetHfc->algorithm, "hfc");
@@ -60,23 +58,25 @@ ofxAAOnsetsAlgorithm::ofxAAOnsetsAlgorithm(ofxAAOneVectorOutputAlgorithm* window
     
     detection_sum.assign(detecBufferSize, 0.0);
     detections.assign(3, vector<Real> (detecBufferSize));
-    silenceThreshold = 0.02;
-    alpha = 0.1;
-    timeThreshold = 100.0;
-    bufferNumThreshold = 7; //116 ms at 60 fps
+    setDefaultParameters();
     lastOnsetTime = 0;
     lastOnsetBufferNum = 0;
     addHfc = addComplex = addFlux = true;
     hfc_max = complex_max = flux_max = 0.0;
-    usingTimeThreshold = true;
     bufferCounter = 0;
     _value = false;
-    onsetsMode = TIME_BASED;
     
 }
+//-------------------------------------------
+void ofxAAOnsetsAlgorithm::setDefaultParameters(){
+    silenceThreshold = 0.02;
+    alpha = 0.1;
+    timeThreshold = 100.0;
+    bufferNumThreshold = 7; //116 ms at 60 fps
+    usingTimeThreshold = true;
+    onsetsMode = TIME_BASED;
+}
 void ofxAAOnsetsAlgorithm::connectAlgorithms(){
-    fft->algorithm->input("frame").set(windowing->outputValues);
-    fft->algorithm->output("fft").set(fft->complexValues);
     cartesianToPolar->algorithm->input("complex").set(fft->complexValues);
     cartesianToPolar->algorithm->output("magnitude").set(cartesianToPolar->outputValues);
     cartesianToPolar->algorithm->output("phase").set(cartesianToPolar->outputValues_2);
@@ -94,10 +94,19 @@ void ofxAAOnsetsAlgorithm::connectAlgorithms(){
     onsetFlux->algorithm->output("onsetDetection").set(onsetFlux->outputValue);
 }
 
+//-------------------------------------------
+size_t ofxAAOnsetsAlgorithm::getOutputBytes(){
+    size_t bytes = cartesianToPolar->getOutputBytes() + detection_sum.size() * sizeof(Real);
+    for (auto& detection : detections){ bytes += detection.size() * sizeof(Real); }
+    return bytes;
+}
+//-------------------------------------------
+void ofxAAOnsetsAlgorithm::reserveBuffers(ofxaa::Arena& arena){
+    cartesianToPolar->reserveBuffers(arena);
+}
 //-------------------------------------------
 void ofxAAOnsetsAlgorithm::compute(){
     if (isActive){
-        fft->compute();
         cartesianToPolar->compute();
         onsetHfc->compute();
         onsetComplex->compute();
@@ -240,9 +249,21 @@ void ofxAAOnsetsAlgorithm::reset(){
     bufferCounter = 0;
 }
 
+//----------------------------------------------
+void ofxAAOnsetsAlgorithm::resetAlgorithm(){
+    ofxAABaseAlgorithm::resetAlgorithm();
+    cartesianToPolar->resetAlgorithm();
+    reset();
+    for (auto& detection : detections){
+        std::fill(detection.begin(), detection.end(), 0.0);
+    }
+    setDefaultParameters();
+    lastOnsetTime = 0;
+    lastOnsetBufferNum = 0;
+    _value = false;
+}
 //----------------------------------------------
 void ofxAAOnsetsAlgorithm::deleteAlgorithm(){
-    delete fft->algorithm;
     delete cartesianToPolar->algorithm;
     delete onsetHfc->algorithm;
     delete onsetComplex->algorithm;
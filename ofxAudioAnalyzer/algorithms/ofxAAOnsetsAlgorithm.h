@@ -37,16 +37,27 @@ class ofxAAOnsetsAlgorithm : public ofxAABaseAlgorithm{
 
 public:
     
-    ofxAAOnsetsAlgorithm(ofxAAOneVectorOutputAlgorithm* windowingAlgorithm, int samplerate, int framesize);
+    ///fftAlgorithm is shared with the Network spectrum and computed by it.
+    ofxAAOnsetsAlgorithm(ofxAAVectorComplexOutputAlgorithm* fftAlgorithm, int samplerate, int framesize);
     
     void deleteAlgorithm() override;
     
+    void reserveBuffers(ofxaa::Arena& arena) override;
+    
+    ///Polar spectrum and detection functions history.
+    size_t getOutputBytes() override;
+    
     void compute() override;
     
     
+    ///Clears the detection functions.
     void reset();
+    ///Clears the whole detection state and restores the default parameters.
+    void resetAlgorithm() override;
     
     bool getValue(){return _value;}
+    ///Combined onset detection function of the last frame, normalized to its running maximum.
+    Real getNoveltyValue(){return detection_sum.back();}
     float getOnsetSilenceThreshold(){return silenceThreshold;}
     float getOnsetTimeThreshold(){return timeThreshold;}
     float getOnsetAlpha(){return alpha;}
@@ -61,6 +72,7 @@ public:
 private:
     
     void connectAlgorithms();
+    void setDefaultParameters();
     void evaluate();
     
     bool _value;//isOnset
@@ -69,7 +81,6 @@ private:
     bool onsetTimeThresholdEvaluation();
     bool onsetBufferNumThresholdEvaluation();//framebased threshold eval.
     
-    ofxAAOneVectorOutputAlgorithm* windowing;
     ofxAAVectorComplexOutputAlgorithm* fft;
     ofxAATwoVectorsOutputAlgorithm* cartesianToPolar;
     ofxAASingleOutputAlgorithm* onsetHfc;
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#include "ofxAAPeaksViewAlgorithm.h"
+
+ofxAAPeaksViewAlgorithm::ofxAAPeaksViewAlgorithm(int samplerate, int framesize, Real minFrequency, Real maxFrequency, Real threshold, int maxPeaks, bool orderByFrequency) : ofxAATwoVectorsOutputAlgorithm(ofxaa::SpectralPeaksView, samplerate, framesize) {
+    _peaks = NULL;
+    _minFrequency = minFrequency;
+    _maxFrequency = maxFrequency;
+    _threshold = threshold;
+    _maxPeaks = maxPeaks;
+    _orderByFrequency = orderByFrequency;
+    
+    int capacity = std::min(maxPeaks, (framesize/2)/2 + 2);
+    _sorted.reserve(capacity);
+    outputValues.reserve(capacity);
+    outputValues_2.reserve(capacity);
+}
+//-------------------------------------------
+void ofxAAPeaksViewAlgorithm::compute(){
+    outputValues.clear();
+    outputValues_2.clear();
+    if (!isActive || _peaks == NULL){
+        return;
+    }
+    
+    //Superset is ordered by magnitude: the first matches are the strongest.
+    const vector<Real>& frequencies = _peaks->outputValues;
+    const vector<Real>& magnitudes = _peaks->outputValues_2;
+    _sorted.clear();
+    for (size_t i=0; i<frequencies.size() && (int)_sorted.size() < _maxPeaks; i++){
+        if (magnitudes[i] <= _threshold){ break; }
+        if (frequencies[i] < _minFrequency || frequencies[i] > _maxFrequency){ continue; }
+        _sorted.push_back(make_pair(frequencies[i], magnitudes[i]));
+    }
+    
+    if (_orderByFrequency){
+        std::sort(_sorted.begin(), _sorted.end());
+    }
+    for (const auto& peak : _sorted){
+        outputValues.push_back(peak.first);
+        outputValues_2.push_back(peak.second);
+    }
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#pragma once
+
+#include "ofxAASpectralPeaksAlgorithm.h"
+
+///Filtered view of an ofxAASpectralPeaksAlgorithm superset, with SpectralPeaks parameters.
+///Takes the strongest maxPeaks peaks passing the filters, ordered by frequency or by magnitude.
+///outputValues holds frequencies, outputValues_2 magnitudes, like Essentia's SpectralPeaks outputs.
+class ofxAAPeaksViewAlgorithm : public ofxAATwoVectorsOutputAlgorithm {
+public:
+    
+    ofxAAPeaksViewAlgorithm(int samplerate, int framesize, Real minFrequency, Real maxFrequency, Real threshold, int maxPeaks, bool orderByFrequency);
+    
+    void compute() override;
+    
+    void setPeaksInput(ofxAASpectralPeaksAlgorithm* peaks){ _peaks = peaks; }
+    
+private:
+    ofxAASpectralPeaksAlgorithm* _peaks;
+    vector< pair<Real, Real> > _sorted;
+    
+    Real _minFrequency;
+    Real _maxFrequency;
+    Real _threshold;
+    int _maxPeaks;
+    bool _orderByFrequency;
+    
+};
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+#pragma once
+
+#include <cmath>
+
+#include "types.h"
+
+namespace ofxaa {
+    
+    ///12 bins chroma (HPCP) helpers shared by the chords and key nodes. Index 0 is on A.
+    
+    inline const char* pitchClassName(int pitchClass){
+        static const char* names[] = {"A", "Bb", "B", "C", "C#", "D", "Eb", "E", "F", "F#", "G", "Ab"};
+        return names[((pitchClass % 12) + 12) % 12];
+    }
+    
+    ///Zero mean, unit norm in place, so correlating with the template is a dot product.
+    inline void normalizeTemplate(essentia::Real* t){
+        essentia::Real mean = 0.0;
+        for (int i=0; i<12; i++){ mean += t[i]; }
+        mean /= 12.0;
+        essentia::Real norm = 0.0;
+        for (int i=0; i<12; i++){
+            t[i] -= mean;
+            norm += t[i] * t[i];
+        }
+        norm = sqrt(norm);
+        if (norm <= 0.0){ return; }
+        for (int i=0; i<12; i++){ t[i] /= norm; }
+    }
+    
+    ///Removes the mean of chroma into centered, returns the norm of centered.
+    inline essentia::Real centerChroma(const essentia::Real* chroma, essentia::Real* centered){
+        essentia::Real mean = 0.0;
+        for (int i=0; i<12; i++){ mean += chroma[i]; }
+        mean /= 12.0;
+        essentia::Real norm = 0.0;
+        for (int i=0; i<12; i++){
+            centered[i] = chroma[i] - mean;
+            norm += centered[i] * centered[i];
+        }
+        return sqrt(norm);
+    }
+    
+    ///Index of the normalized template best correlated with a centered chroma, its dot product in correlation.
+    inline int bestTemplate(const essentia::Real* centered, const essentia::Real (*templates)[12], int templatesNum, essentia::Real& correlation){
+        int best = 0;
+        correlation = -1.0;
+        for (int k=0; k<templatesNum; k++){
+            const essentia::Real* t = templates[k];
+            essentia::Real c = 0.0;
+            for (int i=0; i<12; i++){ c += centered[i] * t[i]; }
+            if (c > correlation){
+                correlation = c;
+                best = k;
+            }
+        }
+        return best;
+    }
+}
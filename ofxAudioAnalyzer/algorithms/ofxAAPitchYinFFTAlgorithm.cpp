@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#include "ofxAAPitchYinFFTAlgorithm.h"
+#include "ofxAATableCache.h"
+
+namespace {
+    ///aubio's outer/middle ear weighting, in dB
+    const Real weightingFrequencies[] = {
+        0., 20., 25., 31.5, 40., 50., 63., 80., 100., 125., 160., 200., 250., 315., 400., 500., 630., 800.,
+        1000., 1250., 1600., 2000., 2500., 3150., 4000., 5000., 6300., 8000., 9000., 10000., 12500., 15000., 20000., 25100.
+    };
+    const Real weightingValues[] = {
+        -75.8, -70.1, -60.8, -52.1, -44.2, -37.5, -31.3, -25.6, -20.9, -16.5, -12.6, -9.6, -7.0, -4.7, -3.0, -1.8, -0.8, -0.2,
+        -0.0, 0.5, 1.6, 3.2, 5.4, 7.8, 8.1, 5.3, -2.4, -11.1, -12.8, -12.2, -7.4, -17.8, -17.8, -17.8
+    };
+    const int weightingSize = sizeof(weightingFrequencies) / sizeof(Real);
+    
+    ///Weighting of each power spectrum bin, a lookup table shared by the algorithms of a format.
+    std::shared_ptr<const vector<Real> > getWeights(int samplerate, int framesize){
+        typedef std::pair<int, int> Key;
+        static ofxaa::TableCache<vector<Real>, Key> tables;
+        
+        return tables.get(Key(samplerate, framesize), [=](){
+            auto weights = std::make_shared<vector<Real> >(framesize/2 + 1);
+            int j = 0;
+            for (size_t i=0; i<weights->size(); i++){
+                Real frequency = Real(i) / framesize * samplerate;
+                while (j < weightingSize - 2 && frequency > weightingFrequencies[j+1]){ j++; }
+                Real f0 = weightingFrequencies[j];
+                Real f1 = weightingFrequencies[j+1];
+                Real db = weightingValues[j] + (weightingValues[j+1] - weightingValues[j]) * (frequency - f0) / (f1 - f0);
+                (*weights)[i] = pow(10.0, 0.05 * db);
+            }
+            return weights;
+        });
+    }
+}
+
+ofxAAPitchYinFFTAlgorithm::ofxAAPitchYinFFTAlgorithm(int samplerate, int framesize, Real minFrequency, Real maxFrequency) : ofxAAOneVectorOutputAlgorithm(ofxaa::PowerPitchYinFFT, samplerate, framesize, 2) {
+    _powerSpectrum = NULL;
+    _samplerate = samplerate;
+    _framesize = framesize;
+    _frameDivisor = 1;
+    _differenceEnd = 0;
+    _cumulativeDifference = 0.0;
+    _isTracking = false;
+    _previousTau = 0.0;
+    _previousConfidence = 0.0;
+    
+    int spectrumSize = framesize/2 + 1;
+    _weightedPower = fftwf_alloc_complex(spectrumSize);
+    _autocorrelation = fftwf_alloc_real(framesize);
+    std::fill((float*)_weightedPower, (float*)(_weightedPower + spectrumSize), 0.0f);
+    _plan = ofxaa::getFftPlan(ofxaa::COMPLEX_TO_REAL_FFT, framesize);
+    //Planned up front so switching frame size never plans on the audio path.
+    _reducedPlan = ofxaa::getFftPlan(ofxaa::COMPLEX_TO_REAL_FFT, framesize/2);
+    
+    _yin.assign(spectrumSize, 1.0);
+    _weights = getWeights(samplerate, framesize);
+    setFrequencyRange(minFrequency, maxFrequency);
+    _defaultMinFrequency = _minFrequency;
+    _defaultMaxFrequency = _maxFrequency;
+}
+//-------------------------------------------
+ofxAAPitchYinFFTAlgorithm::~ofxAAPitchYinFFTAlgorithm(){
+    fftwf_free(_weightedPower);
+    fftwf_free(_autocorrelation);
+}
+//-------------------------------------------
+void ofxAAPitchYinFFTAlgorithm::setFrequencyRange(Real minFrequency, Real maxFrequency){
+    if (minFrequency > maxFrequency){
+        cout << "ofxAAPitchYinFFT: min frequency is higher than max frequency." << endl;
+        std::swap(minFrequency, maxFrequency);
+    }
+    _minFrequency = minFrequency;
+    _maxFrequency = maxFrequency;
+    updateLagRange();
+}
+//-------------------------------------------
+void ofxAAPitchYinFFTAlgorithm::updateLagRange(){
+    Real samplerate = _samplerate / _frameDivisor;
+    int maxLag = _framesize / (2 * _frameDivisor);
+    _tauMax = std::min(int(ceil(samplerate / std::max(_minFrequency, (Real)1.0))), maxLag);
+    _tauMin = std::max(std::min(int(floor(samplerate / std::max(_maxFrequency, (Real)1.0))), maxLag), 1);
+}
+//-------------------------------------------
+void ofxAAPitchYinFFTAlgorithm::setReducedFrame(bool reduced){
+    int divisor = reduced ? 2 : 1;
+    if (divisor == _frameDivisor){ return; }
+    _frameDivisor = divisor;
+    updateLagRange();
+    //Previous lags are in the other frame's samples.
+    _previousTau = 0.0;
+    _previousConfidence = 0.0;
+}
+//-------------------------------------------
+void ofxAAPitchYinFFTAlgorithm::saveDefaults(){
+    ofxAAOneVectorOutputAlgorithm::saveDefaults();
+    _defaultMinFrequency = _minFrequency;
+    _defaultMaxFrequency = _maxFrequency;
+}
+//-------------------------------------------
+void ofxAAPitchYinFFTAlgorithm::resetAlgorithm(){
+    ofxAAOneVectorOutputAlgorithm::resetAlgorithm();
+    setReducedFrame(false);
+    setFrequencyRange(_defaultMinFrequency, _defaultMaxFrequency);
+    setTrackingEnabled(false);
+}
+//-------------------------------------------
+void ofxAAPitchYinFFTAlgorithm::setTrackingEnabled(bool enabled){
+    _isTracking = enabled;
+    _previousTau = 0.0;
+    _previousConfidence = 0.0;
+}
+//-------------------------------------------
+bool ofxAAPitchYinFFTAlgorithm::computeAutocorrelation(){
+    int bins = _framesize / (2 * _frameDivisor) + 1;
+    int size = std::min((int)_powerSpectrum->size(), bins);
+    const Real* power = _powerSpectrum->data();
+    const Real* weights = _weights->data();
+    
+    //Refilled every frame: a c2r transform overwrites its input.
+    Real sum = 0.0;
+    for (int i=0; i<bins; i++){
+        Real p = i < size ? power[i] * weights[i] : 0.0;
+        _weightedPower[i][0] = p;
+        _weightedPower[i][1] = 0.0;
+        sum += p;
+    }
+    if (sum == 0.0){ return false; }
+    
+    if (_frameDivisor > 1){
+        _reducedPlan->execute(_weightedPower, _autocorrelation);
+    } else {
+        _plan->execute(_weightedPower, _autocorrelation);
+    }
+    
+    _yin[0] = 1.0;
+    _differenceEnd = 0;
+    _cumulativeDifference = 0.0;
+    return true;
+}
+//-------------------------------------------
+void ofxAAPitchYinFFTAlgorithm::normalizeDifference(int tauEnd){
+    //Difference function d(tau) = r(0) - r(tau), normalized by its cumulative mean.
+    Real* yin = _yin.data();
+    Real r0 = _autocorrelation[0];
+    Real cumulative = _cumulativeDifference;
+    tauEnd = std::min(tauEnd, (int)_yin.size() - 1);
+    for (int tau=_differenceEnd+1; tau<=tauEnd; tau++){
+        Real difference = r0 - _autocorrelation[tau];
+        cumulative += difference;
+        yin[tau] = cumulative != 0.0 ? difference * tau / cumulative : 1.0;
+    }
+    _cumulativeDifference = cumulative;
+    _differenceEnd = std::max(_differenceEnd, tauEnd);
+}
+//-------------------------------------------
+Real ofxAAPitchYinFFTAlgorithm::searchMinimum(int tauLow, int tauHigh, Real& minimum){
+    const Real* yin = _yin.data();
+    int tau = tauLow;
+    for (int i=tauLow+1; i<=tauHigh; i++){
+        tau = yin[i] < yin[tau] ? i : tau;
+    }
+    minimum = yin[tau];
+    
+    if (tau <= 1 || tau >= _differenceEnd){ return tau; }
+    Real a = yin[tau-1];
+    Real b = yin[tau];
+    Real c = yin[tau+1];
+    Real denominator = a - 2.0*b + c;
+    if (denominator <= 0.0){ return tau; }
+    Real offset = 0.5 * (a - c) / denominator;
+    minimum = b - 0.25 * (a - c) * offset;
+    return tau + offset;
+}
+//-------------------------------------------
+void ofxAAPitchYinFFTAlgorithm::compute(){
+    outputValues[0] = 0.0;
+    outputValues[1] = 0.0;
+    if (!isActive || _powerSpectrum == NULL || !computeAutocorrelation()){
+        _previousConfidence = 0.0;
+        return;
+    }
+    
+    Real minimum = 1.0;
+    Real tau = 0.0;
+    bool isTracked = false;
+    if (_isTracking && _previousConfidence >= PITCH_YIN_TRACKING_CONFIDENCE){
+        int tauLow = std::max(_tauMin, int(floor(_previousTau * (1.0 - PITCH_YIN_TRACKING_WINDOW))));
+        int tauHigh = std::min(_tauMax, int(ceil(_previousTau * (1.0 + PITCH_YIN_TRACKING_WINDOW))));
+        if (tauLow < tauHigh){
+            //One lag past the window for the parabola.
+            normalizeDifference(tauHigh + 1);
+            tau = searchMinimum(tauLow, tauHigh, minimum);
+            //A minimum on the window edge may continue outside of it.
+            int lag = int(tau + 0.5);
+            bool isOnEdge = (lag <= tauLow && tauLow > _tauMin) || (lag >= tauHigh && tauHigh < _tauMax);
+            isTracked = !isOnEdge && (1.0 - minimum) >= PITCH_YIN_TRACKING_CONFIDENCE;
+        }
+    }
+    if (!isTracked){
+        normalizeDifference(_tauMax);
+        tau = searchMinimum(_tauMin, _tauMax, minimum);
+    }
+    
+    Real confidence = std::max((Real)0.0, std::min((Real)1.0, (Real)1.0 - minimum));
+    if (tau > 0.0){
+        outputValues[0] = _samplerate / (_frameDivisor * tau);
+        outputValues[1] = confidence;
+    }
+    _previousTau = tau;
+    _previousConfidence = tau > 0.0 ? confidence : 0.0;
+}
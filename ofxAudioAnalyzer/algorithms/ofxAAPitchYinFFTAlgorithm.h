@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#pragma once
+
+#include "ofxAAOneVectorOutputAlgorithm.h"
+#include "ofxAAFftPlan.h"
+
+#define PITCH_YIN_MIN_FREQUENCY 20.0
+#define PITCH_YIN_MAX_FREQUENCY 22050.0
+#define PITCH_YIN_TRACKING_CONFIDENCE 0.8
+#define PITCH_YIN_TRACKING_WINDOW 0.2 //fraction of the previous period
+
+///YIN-FFT pitch (Brossier's aubio method, as Essentia's PitchYinFFT) computed from the shared power spectrum.
+///The autocorrelation is the inverse FFT of the weighted power spectrum, with shared FFTW plans.
+///outputValues[0] is the pitch in Hz, outputValues[1] the confidence (0-1).
+class ofxAAPitchYinFFTAlgorithm : public ofxAAOneVectorOutputAlgorithm {
+public:
+    
+    ofxAAPitchYinFFTAlgorithm(int samplerate, int framesize, Real minFrequency = PITCH_YIN_MIN_FREQUENCY, Real maxFrequency = PITCH_YIN_MAX_FREQUENCY);
+    ~ofxAAPitchYinFFTAlgorithm();
+    
+    void compute() override;
+    
+    void setPowerSpectrumInput(vector<Real>& powerSpectrum){ _powerSpectrum = &powerSpectrum; }
+    
+    ///Pitch search range in Hz. Lags outside the frame are clamped.
+    void setFrequencyRange(Real minFrequency, Real maxFrequency);
+    
+    ///When enabled and the previous frame was confident, only lags around the previous period are searched.
+    ///Falls back to the full range when that search isn't confident.
+    ///The inverse FFT still runs every frame: the cumulative mean needs every lag below the window,
+    ///and computing those lags directly costs more than the transform.
+    void setTrackingEnabled(bool enabled);
+    bool getTrackingEnabled(){ return _isTracking; }
+    
+    ///Uses only the lower half of the spectrum with a half size inverse FFT: the autocorrelation
+    ///of the frame decimated by 2. Halves the cost and the lag resolution, the max pitch drops to samplerate/4.
+    void setReducedFrame(bool reduced);
+    bool getReducedFrame(){ return _frameDivisor > 1; }
+    
+    void saveDefaults() override;
+    ///Full frame, no tracking and the saved frequency range.
+    void resetAlgorithm() override;
+    
+private:
+    ///Lag range of the current frame divisor.
+    void updateLagRange();
+    ///Weighted autocorrelation of the frame, returns false on a silent frame.
+    bool computeAutocorrelation();
+    ///Extends the cumulative mean normalized difference up to tauEnd.
+    void normalizeDifference(int tauEnd);
+    ///Lag of the lowest normalized difference in [tauLow, tauHigh], refined with a parabola.
+    Real searchMinimum(int tauLow, int tauHigh, Real& minimum);
+    
+    vector<Real>* _powerSpectrum;
+    
+    Real _samplerate;
+    int _framesize;
+    int _frameDivisor;
+    Real _minFrequency;
+    Real _maxFrequency;
+    Real _defaultMinFrequency;
+    Real _defaultMaxFrequency;
+    int _tauMin;
+    int _tauMax;
+    int _differenceEnd;
+    Real _cumulativeDifference;
+    
+    bool _isTracking;
+    Real _previousTau;
+    Real _previousConfidence;
+    
+    std::shared_ptr<const vector<Real> > _weights;
+    vector<Real> _yin;
+    
+    fftwf_complex* _weightedPower;
+    float* _autocorrelation;
+    std::shared_ptr<const ofxaa::FftPlan> _plan;
+    std::shared_ptr<const ofxaa::FftPlan> _reducedPlan;
+    
+};
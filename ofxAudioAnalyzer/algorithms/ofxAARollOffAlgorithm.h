@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#pragma once
+
+#include "ofxAASingleOutputAlgorithm.h"
+#include "ofxAAEnergyIndexAlgorithm.h"
+
+///Roll-off frequency (Essentia's RollOff) found by a binary search on the cumulative energy index.
+class ofxAARollOffAlgorithm : public ofxAASingleOutputAlgorithm {
+public:
+    
+    ///\param cutoff: ratio of the total energy below the roll-off frequency.
+    ofxAARollOffAlgorithm(int samplerate, int framesize, Real cutoff = 0.85);
+    
+    void compute() override;
+    
+    void setEnergyIndexInput(ofxAAEnergyIndexAlgorithm* energyIndex){ _energyIndex = energyIndex; }
+    
+    Real getCutoff(){ return _cutoff; }
+    void setCutoff(Real cutoff){ _cutoff = cutoff; }
+    
+private:
+    ofxAAEnergyIndexAlgorithm* _energyIndex;
+    Real _cutoff;
+    
+};
@@ -39,6 +39,13 @@ void ofxAASingleOutputAlgorithm::compute(){
     }
 }
 //-------------------------------------------
+void ofxAASingleOutputAlgorithm::resetAlgorithm(){
+    ofxAABaseAlgorithm::resetAlgorithm();
+    outputValue = 0.0;
+    _smoothedValue = 0.0;
+    _smoothedNormValue = 0.0;
+}
+//-------------------------------------------
 float ofxAASingleOutputAlgorithm::getValue(float smooth, bool normalized){
     if (normalized){
         float normValue = normalizedValue();
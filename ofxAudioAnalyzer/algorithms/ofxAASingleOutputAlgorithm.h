@@ -35,8 +35,12 @@ public:
     
     Real outputValue;
     
+    size_t getOutputBytes() override { return sizeof(Real); }
+    
     float getValue(float smooth, bool normalized);
     
+    void resetAlgorithm() override;
+    
 private:
     
     float normalizedValue();
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#include "ofxAASpectralPeaksAlgorithm.h"
+
+#include <functional>
+
+ofxAASpectralPeaksAlgorithm::ofxAASpectralPeaksAlgorithm(int samplerate, int framesize, Real minFrequency, Real maxFrequency, Real threshold, int maxPeaks) : ofxAATwoVectorsOutputAlgorithm(ofxaa::SpectralPeaksSet, samplerate, framesize) {
+    _spectrum = NULL;
+    _samplerate = samplerate;
+    _minFrequency = minFrequency;
+    _maxFrequency = maxFrequency;
+    _threshold = threshold;
+    _maxPeaks = maxPeaks;
+    
+    //No peaks can be closer than every other bin.
+    int capacity = std::min(maxPeaks, (framesize/2)/2 + 2);
+    _heap.reserve(capacity + 1);
+    _isMaximum.assign((framesize/2)+1, 0);
+    outputValues.reserve(capacity);
+    outputValues_2.reserve(capacity);
+}
+//-------------------------------------------
+void ofxAASpectralPeaksAlgorithm::compute(){
+    outputValues.clear();
+    outputValues_2.clear();
+    if (!isActive || _spectrum == NULL || _spectrum->size() < 2){
+        return;
+    }
+    
+    const Real* x = _spectrum->data();
+    int size = (int)_spectrum->size();
+    Real binToFrequency = (_samplerate / 2.0) / (size - 1);
+    int firstBin = std::max(0, int(ceil(_minFrequency / binToFrequency)) - 1);
+    int lastBin = std::min(size - 1, int(floor(_maxFrequency / binToFrequency)) + 1);
+    if ((int)_isMaximum.size() < size){ _isMaximum.resize(size); }
+    
+    //Local maxima mask: branchless loop over contiguous bins.
+    //Rising on the left, not falling on the right: a plateau is found at its first bin.
+    char* isMaximum = _isMaximum.data();
+    int start = std::max(firstBin, 1);
+    int stop = std::min(lastBin, size - 2);
+    for (int k=start; k<=stop; k++){
+        isMaximum[k] = (x[k] > x[k-1]) & (x[k] >= x[k+1]) & (x[k] > _threshold);
+    }
+    //Spectrum ends only need one neighbour
+    if (firstBin == 0){ isMaximum[0] = (x[0] > x[1]) & (x[0] > _threshold); }
+    if (lastBin == size - 1){ isMaximum[size-1] = (x[size-1] > x[size-2]) & (x[size-1] > _threshold); }
+    
+    //Bounded top-K: min-heap on magnitude holding the strongest peaks so far.
+    _heap.clear();
+    for (int k=firstBin; k<=lastBin; k++){
+        if (!isMaximum[k]){ continue; }
+        
+        Real bin = k;
+        Real magnitude = x[k];
+        if (k > 0 && k < size - 1){
+            //Parabolic interpolation
+            Real left = x[k-1], middle = x[k], right = x[k+1];
+            Real denominator = left - 2*middle + right;
+            if (denominator != 0.0){
+                Real delta = 0.5 * (left - right) / denominator;
+                bin = k + delta;
+                magnitude = middle - 0.25 * (left - right) * delta;
+            }
+        }
+        
+        Peak peak;
+        peak.frequency = bin * binToFrequency;
+        peak.magnitude = magnitude;
+        if (peak.frequency < _minFrequency || peak.frequency > _maxFrequency){ continue; }
+        
+        if ((int)_heap.size() < _maxPeaks){
+            _heap.push_back(peak);
+            std::push_heap(_heap.begin(), _heap.end(), std::greater<Peak>());
+        } else if (peak.magnitude > _heap.front().magnitude){
+            std::pop_heap(_heap.begin(), _heap.end(), std::greater<Peak>());
+            _heap.back() = peak;
+            std::push_heap(_heap.begin(), _heap.end(), std::greater<Peak>());
+        }
+    }
+    
+    //Min-heap sorted with greater<>: strongest first.
+    std::sort_heap(_heap.begin(), _heap.end(), std::greater<Peak>());
+    for (const auto& peak : _heap){
+        outputValues.push_back(peak.frequency);
+        outputValues_2.push_back(peak.magnitude);
+    }
+}
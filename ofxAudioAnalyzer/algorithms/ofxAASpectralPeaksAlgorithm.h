@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#pragma once
+
+#include "ofxAATwoVectorsOutputAlgorithm.h"
+
+///Single peak-picking pass over the magnitude spectrum (Essentia's SpectralPeaks with interpolation).
+///Keeps the strongest maxPeaks peaks of [minFrequency, maxFrequency] above threshold,
+///ordered by magnitude (descending): outputValues holds frequencies, outputValues_2 magnitudes.
+///Consumers read filtered views of this superset (ofxAAPeaksViewAlgorithm) instead of rescanning the spectrum.
+class ofxAASpectralPeaksAlgorithm : public ofxAATwoVectorsOutputAlgorithm {
+public:
+    
+    ofxAASpectralPeaksAlgorithm(int samplerate, int framesize, Real minFrequency, Real maxFrequency, Real threshold, int maxPeaks);
+    
+    void compute() override;
+    
+    void setSpectrumInput(vector<Real>& spectrum){ _spectrum = &spectrum; }
+    
+    int getPeaksNum() const { return (int)outputValues.size(); }
+    
+private:
+    struct Peak {
+        Real frequency;
+        Real magnitude;
+        bool operator>(const Peak& other) const { return magnitude > other.magnitude; }
+    };
+    
+    vector<Real>* _spectrum;
+    vector<Peak> _heap;
+    vector<char> _isMaximum;
+    
+    Real _minFrequency;
+    Real _maxFrequency;
+    Real _threshold;
+    int _maxPeaks;
+    Real _samplerate;
+    
+};
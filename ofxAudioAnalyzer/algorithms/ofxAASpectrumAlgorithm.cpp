@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#include "ofxAASpectrumAlgorithm.h"
+
+ofxAASpectrumAlgorithm::ofxAASpectrumAlgorithm(int samplerate, int framesize) : ofxAATwoVectorsOutputAlgorithm(ofxaa::PowerSpectrum, samplerate, framesize, (framesize/2)+1, (framesize/2)+1) {
+    _fftValues = NULL;
+}
+//-------------------------------------------
+void ofxAASpectrumAlgorithm::compute(){
+    if (!isActive || _fftValues == NULL){
+        std::fill(outputValues.begin(), outputValues.end(), 0.0);
+        std::fill(outputValues_2.begin(), outputValues_2.end(), 0.0);
+        return;
+    }
+    
+    const complex<Real>* fft = _fftValues->data();
+    Real* magnitudes = outputValues.data();
+    Real* powers = outputValues_2.data();
+    int size = std::min(_fftValues->size(), outputValues.size());
+    
+    for (int i=0; i<size; i++){
+        Real re = fft[i].real();
+        Real im = fft[i].imag();
+        Real p = re*re + im*im;
+        powers[i] = p;
+        magnitudes[i] = sqrt(p);
+    }
+}
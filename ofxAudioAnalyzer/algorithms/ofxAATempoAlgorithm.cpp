@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#include "ofxAATempoAlgorithm.h"
+
+ofxAATempoAlgorithm::ofxAATempoAlgorithm(int samplerate, int framesize) : ofxAAOneVectorOutputAlgorithm(ofxaa::NoveltyTempo, samplerate, framesize, 2) {
+    _onsets = NULL;
+    _framePeriod = Real(framesize) / samplerate;
+    
+    int size = TEMPO_WINDOW_FRAMES * 2;
+    _signal = fftwf_alloc_real(size);
+    _spectrum = fftwf_alloc_complex(size/2 + 1);
+    _forwardPlan = ofxaa::getFftPlan(ofxaa::REAL_TO_COMPLEX_FFT, size);
+    _inversePlan = ofxaa::getFftPlan(ofxaa::COMPLEX_TO_REAL_FFT, size);
+    
+    reset();
+}
+//-------------------------------------------
+ofxAATempoAlgorithm::~ofxAATempoAlgorithm(){
+    fftwf_free(_signal);
+    fftwf_free(_spectrum);
+}
+//-------------------------------------------
+void ofxAATempoAlgorithm::reset(){
+    _novelty.assign(TEMPO_WINDOW_FRAMES, 0.0);
+    _noveltyIndex = 0;
+    _framesNum = 0;
+    _framesSinceUpdate = 0;
+    outputValues[0] = 0.0;
+    outputValues[1] = 0.0;
+}
+//-------------------------------------------
+void ofxAATempoAlgorithm::resetAlgorithm(){
+    ofxAAOneVectorOutputAlgorithm::resetAlgorithm();
+    reset();
+}
+//-------------------------------------------
+void ofxAATempoAlgorithm::compute(){
+    if (!isActive || _onsets == NULL){
+        outputValues[0] = 0.0;
+        outputValues[1] = 0.0;
+        return;
+    }
+    _novelty[_noveltyIndex] = _onsets->getNoveltyValue();
+    _noveltyIndex = (_noveltyIndex + 1) % TEMPO_WINDOW_FRAMES;
+    _framesNum = std::min(_framesNum + 1, TEMPO_WINDOW_FRAMES);
+    
+    //The estimation holds between updates.
+    if (++_framesSinceUpdate >= TEMPO_UPDATE_FRAMES){
+        _framesSinceUpdate = 0;
+        estimateTempo();
+    }
+}
+//-------------------------------------------
+void ofxAATempoAlgorithm::estimateTempo(){
+    int size = TEMPO_WINDOW_FRAMES * 2;
+    int minLag = std::max(1, int(floor(60.0 / (TEMPO_MAX_BPM * _framePeriod))));
+    int maxLag = std::min(_framesNum / 2, int(ceil(60.0 / (TEMPO_MIN_BPM * _framePeriod))));
+    if (maxLag <= minLag + 1){ return; }
+    
+    //Oldest frame first, mean removed, zero padded so the autocorrelation doesn't wrap.
+    Real mean = 0.0;
+    for (int i=0; i<_framesNum; i++){ mean += _novelty[i]; }
+    mean /= _framesNum;
+    int oldest = _framesNum < TEMPO_WINDOW_FRAMES ? 0 : _noveltyIndex;
+    for (int i=0; i<_framesNum; i++){
+        _signal[i] = _novelty[(oldest + i) % TEMPO_WINDOW_FRAMES] - mean;
+    }
+    std::fill(_signal + _framesNum, _signal + size, 0.0f);
+    
+    _forwardPlan->execute(_signal, _spectrum);
+    for (int k=0; k<=size/2; k++){
+        Real re = _spectrum[k][0];
+        Real im = _spectrum[k][1];
+        _spectrum[k][0] = re*re + im*im;
+        _spectrum[k][1] = 0.0;
+    }
+    _inversePlan->execute(_spectrum, _signal);
+    
+    const float* acf = _signal;
+    if (acf[0] <= 0.0){
+        outputValues[0] = 0.0;
+        outputValues[1] = 0.0;
+        return;
+    }
+    
+    //Unbiased autocorrelation weighted by the tempo prior.
+    int bestLag = 0;
+    Real bestScore = 0.0;
+    for (int lag=minLag; lag<=maxLag; lag++){
+        Real r = acf[lag] * _framesNum / (_framesNum - lag);
+        Real octaves = log2(60.0 / (lag * _framePeriod) / TEMPO_PRIOR_BPM) / TEMPO_PRIOR_OCTAVES;
+        Real score = r * exp(-0.5 * octaves * octaves);
+        if (score > bestScore){
+            bestScore = score;
+            bestLag = lag;
+        }
+    }
+    if (bestLag == 0){
+        outputValues[1] = 0.0;
+        return;
+    }
+    
+    Real lag = bestLag;
+    if (bestLag > minLag && bestLag < maxLag){
+        Real a = acf[bestLag-1];
+        Real b = acf[bestLag];
+        Real c = acf[bestLag+1];
+        Real denominator = a - 2.0*b + c;
+        if (denominator < 0.0){
+            lag += 0.5 * (a - c) / denominator;
+        }
+    }
+    outputValues[0] = 60.0 / (lag * _framePeriod);
+    outputValues[1] = std::max((Real)0.0, std::min((Real)1.0, acf[bestLag] * _framesNum / ((_framesNum - bestLag) * acf[0])));
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#pragma once
+
+#include "ofxAAOneVectorOutputAlgorithm.h"
+#include "ofxAAOnsetsAlgorithm.h"
+#include "ofxAAFftPlan.h"
+
+#define TEMPO_WINDOW_FRAMES 512 //~8.5s at 60 frames per second
+#define TEMPO_UPDATE_FRAMES 16
+#define TEMPO_MIN_BPM 40.0
+#define TEMPO_MAX_BPM 240.0
+#define TEMPO_PRIOR_BPM 120.0
+#define TEMPO_PRIOR_OCTAVES 1.0 //log2 standard deviation of the prior
+
+///Tempo from the periodicity of the onsets detection function.
+///The detection function is kept in a ring of TEMPO_WINDOW_FRAMES frames. Every TEMPO_UPDATE_FRAMES frames
+///its autocorrelation is computed with two FFTW transforms (shared plans) and the strongest lag,
+///weighted by a log-Gaussian prior around TEMPO_PRIOR_BPM, gives the tempo.
+///Frames come at the host's cook rate, the Network sets their period from the host timeline.
+///outputValues[0] is the tempo in BPM, outputValues[1] the confidence (0-1).
+class ofxAATempoAlgorithm : public ofxAAOneVectorOutputAlgorithm {
+public:
+    
+    ofxAATempoAlgorithm(int samplerate, int framesize);
+    ~ofxAATempoAlgorithm();
+    
+    void compute() override;
+    
+    void setOnsetsInput(ofxAAOnsetsAlgorithm* onsets){ _onsets = onsets; }
+    
+    ///Clears the detection function history.
+    void reset();
+    void resetAlgorithm() override;
+    
+    ///Seconds between frames, bufferSize/sampleRate until set.
+    void setFramePeriod(Real seconds){ _framePeriod = seconds; }
+    Real getFramePeriod(){ return _framePeriod; }
+    ///Seconds between beats at the last estimated tempo, 0 when there is none.
+    Real getBeatPeriod(){ return outputValues[0] > 0.0 ? 60.0 / outputValues[0] : 0.0; }
+    
+private:
+    void estimateTempo();
+    
+    ofxAAOnsetsAlgorithm* _onsets;
+    
+    vector<Real> _novelty;///ring, TEMPO_WINDOW_FRAMES
+    int _noveltyIndex;
+    int _framesNum;
+    int _framesSinceUpdate;
+    
+    Real _framePeriod;
+    
+    float* _signal;///2 x TEMPO_WINDOW_FRAMES, zero padded
+    fftwf_complex* _spectrum;
+    std::shared_ptr<const ofxaa::FftPlan> _forwardPlan;
+    std::shared_ptr<const ofxaa::FftPlan> _inversePlan;
+    
+};
@@ -48,6 +48,23 @@ void ofxAATwoVectorsOutputAlgorithm::checkInternalValuesSizes() {
     }
 }
 
+void ofxAATwoVectorsOutputAlgorithm::reserveBuffers(ofxaa::Arena& arena){
+    ofxAAOneVectorOutputAlgorithm::reserveBuffers(arena);
+    if (outputValues_2.empty()){ return; }
+    arena.reserve(_outputBuffer_2);
+    arena.reserve(_linearValues_2);
+    arena.reserve(_normalizedValues_2);
+    arena.reserve(_smoothedValues_2);
+    arena.reserve(_smoothedValuesNormalized_2);
+}
+
+void ofxAATwoVectorsOutputAlgorithm::resetAlgorithm(){
+    ofxAAOneVectorOutputAlgorithm::resetAlgorithm();
+    std::fill(outputValues_2.begin(), outputValues_2.end(), 0.0);
+    std::fill(_smoothedValues_2.begin(), _smoothedValues_2.end(), 0.0);
+    std::fill(_smoothedValuesNormalized_2.begin(), _smoothedValuesNormalized_2.end(), 0.0);
+}
+
 vector<float>& ofxAATwoVectorsOutputAlgorithm::getValues2(float smooth, bool normalized){
     checkInternalValuesSizes();
     
@@ -38,12 +38,23 @@ public:
     
     vector<float>& getValues2(float smooth, bool normalized);
     
-    vector<Real> outputValues_2;
+    void resetAlgorithm() override;
+    
+    vector<Real>& outputValues_2 = _outputBuffer_2;
+    
+    void reserveBuffers(ofxaa::Arena& arena) override;
+    
+    size_t getOutputBytes() override {
+        return ofxAAOneVectorOutputAlgorithm::getOutputBytes() + outputValues_2.size() * sizeof(Real);
+    }
     
 protected:
-    vector<float> _linearValues_2;
-    vector<float> _normalizedValues_2;
-    vector<float> _smoothedValues_2;
-    vector<float> _smoothedValuesNormalized_2;
+    ofxaa::ArenaVector<float> _linearValues_2;
+    ofxaa::ArenaVector<float> _normalizedValues_2;
+    ofxaa::ArenaVector<float> _smoothedValues_2;
+    ofxaa::ArenaVector<float> _smoothedValuesNormalized_2;
+    
+private:
+    ofxaa::ArenaVector<Real> _outputBuffer_2;
     
 };
@@ -88,15 +88,26 @@ enum ofxAAValue {
     
     INHARMONICITY,
     ODD_TO_EVEN,
+    HARMONIC_SPECTRAL_TILT,
+    HARMONIC_ENERGY,
     STRONG_PEAK,
     
     HPCP_CREST,
     HPCP_ENTROPY,
+    CHORD_INDEX,
+    CHORD_STRENGTH,
+    KEY_INDEX,
+    KEY_MODE,
+    KEY_STRENGTH,
     
     PITCH_YIN_FREQUENCY,
     PITCH_YIN_CONFIDENCE,
     
     ONSETS,
+    TEMPO_BPM,
+    TEMPO_CONFIDENCE,
+    BEAT_PULSE,
+    BEAT_PHASE,
     NONE
 };
 
@@ -106,6 +117,9 @@ enum ofxAABinsValue {
     GFCC_ERB_BANDS,
     BARK_BANDS,
     
+    ENERGY_BANDS,
+    CONSTANT_Q,
+    
     TRISTIMULUS,
     HPCP,
     
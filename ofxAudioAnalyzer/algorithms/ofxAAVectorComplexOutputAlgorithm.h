@@ -30,5 +30,23 @@ class ofxAAVectorComplexOutputAlgorithm : public ofxAABaseAlgorithm{
 public:
     ofxAAVectorComplexOutputAlgorithm(ofxaa::AlgorithmType algorithmType, int samplerate, int framesize) : ofxAABaseAlgorithm(algorithmType, samplerate, framesize){}
     
-    vector< complex<Real> > complexValues;
+    ofxAAVectorComplexOutputAlgorithm(ofxaa::AlgorithmType algorithmType, int samplerate, int framesize, int outputSize) : ofxAABaseAlgorithm(algorithmType, samplerate, framesize){
+        complexValues.assign(outputSize, complex<Real>(0.0, 0.0));
+    }
+    
+    void reserveBuffers(ofxaa::Arena& arena) override {
+        arena.reserve(_complexBuffer);
+    }
+    
+    vector< complex<Real> >& complexValues = _complexBuffer;
+    
+    size_t getOutputBytes() override { return complexValues.size() * sizeof(complex<Real>); }
+    
+    void resetAlgorithm() override {
+        ofxAABaseAlgorithm::resetAlgorithm();
+        std::fill(complexValues.begin(), complexValues.end(), complex<Real>(0.0, 0.0));
+    }
+    
+private:
+    ofxaa::ArenaVector< complex<Real> > _complexBuffer;
 };
@@ -31,5 +31,16 @@ public:
     ofxAAVectorVectorOutputAlgorithm(ofxaa::AlgorithmType algorithmType, int samplerate, int framesize) : ofxAABaseAlgorithm(algorithmType, samplerate, framesize){}
     
     vector < vector <Real> > vectorRealValues;
+    
+    size_t getOutputBytes() override {
+        size_t bytes = 0;
+        for (auto& values : vectorRealValues){ bytes += values.size() * sizeof(Real); }
+        return bytes;
+    }
+    
+    void resetAlgorithm() override {
+        ofxAABaseAlgorithm::resetAlgorithm();
+        vectorRealValues.clear();
+    }
 };
 
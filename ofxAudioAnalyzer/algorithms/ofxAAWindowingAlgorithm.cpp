@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+#include "ofxAAWindowingAlgorithm.h"
+
+ofxAAWindowingAlgorithm::ofxAAWindowingAlgorithm(int samplerate, int framesize, ofxaa::WindowType windowType, bool normalized, bool zeroPhase) : ofxAAOneVectorOutputAlgorithm(ofxaa::SharedWindowing, samplerate, framesize, framesize) {
+    _frame = NULL;
+    _isZeroPhase = zeroPhase;
+    _table = ofxaa::getWindowTable(windowType, framesize, normalized);
+}
+//-------------------------------------------
+void ofxAAWindowingAlgorithm::compute(){
+    if (!isActive || _frame == NULL || (int)_frame->size() < _table->size){
+        std::fill(outputValues.begin(), outputValues.end(), 0.0);
+        return;
+    }
+    _table->apply(_frame->data(), outputValues.data(), _isZeroPhase);
+}
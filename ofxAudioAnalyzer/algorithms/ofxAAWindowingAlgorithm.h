@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+#pragma once
+
+#include "ofxAAOneVectorOutputAlgorithm.h"
+#include "ofxAAWindow.h"
+
+///Windowed frame from a shared ofxaa::WindowTable, in place of Essentia's Windowing
+///(hann, normalized, zero phase and no zero padding by default, as the Essentia defaults).
+class ofxAAWindowingAlgorithm : public ofxAAOneVectorOutputAlgorithm {
+public:
+    
+    ofxAAWindowingAlgorithm(int samplerate, int framesize, ofxaa::WindowType windowType = ofxaa::HANN_WINDOW, bool normalized = true, bool zeroPhase = true);
+    
+    void compute() override;
+    
+    void setFrameInput(vector<Real>& frame){ _frame = &frame; }
+    
+private:
+    std::shared_ptr<const ofxaa::WindowTable> _table;
+    vector<Real>* _frame;
+    bool _isZeroPhase;
+    
+};
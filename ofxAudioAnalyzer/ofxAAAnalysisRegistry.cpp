@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+#include "ofxAAAnalysisRegistry.h"
+
+namespace ofxaa {
+    
+    AnalysisRegistry& AnalysisRegistry::instance(){
+        static AnalysisRegistry registry;
+        return registry;
+    }
+    
+    std::shared_ptr<SharedAnalysis> AnalysisRegistry::acquire(uint32_t opId, const std::string& config, const std::shared_ptr<SharedAnalysis>& current){
+        Key key(opId, config);
+        if (current && current->key == key){
+            return current;
+        }
+        
+        std::lock_guard<std::mutex> lock(_mutex);
+        //Entries whose CHOPs are gone.
+        for (auto it = _analyses.begin(); it != _analyses.end();){
+            if (it->second.expired()){
+                it = _analyses.erase(it);
+            } else {
+                it++;
+            }
+        }
+        
+        auto it = _analyses.find(key);
+        if (it != _analyses.end()){
+            if (auto analysis = it->second.lock()){
+                return analysis;
+            }
+        }
+        
+        std::shared_ptr<SharedAnalysis> analysis;
+        //The registry only holds weak references: one use means the caller's.
+        if (current && current.use_count() == 1){
+            _analyses.erase(current->key);
+            analysis = current;
+        } else {
+            analysis = std::make_shared<SharedAnalysis>();
+        }
+        analysis->key = key;
+        _analyses[key] = analysis;
+        return analysis;
+    }
+    
+    int AnalysisRegistry::getAnalysesNum(){
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _analyses.size();
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "ofxAudioAnalyzer.h"
+
+namespace ofxaa {
+    
+    ///One analyzer shared by every CHOP reading the same input with the same configuration.
+    ///Lock mutex around analyzing and reading it.
+    struct SharedAnalysis {
+        ofxAudioAnalyzer analyzer;
+        std::mutex mutex;
+        ///Input totalCooks of the last analysis, the input is analyzed once per cook.
+        int64_t analyzedCook = -1;
+        
+        ///Returns true the first time it is called for a cook: the caller analyzes it.
+        bool beginCook(int64_t totalCooks){
+            if (totalCooks == analyzedCook){ return false; }
+            analyzedCook = totalCooks;
+            return true;
+        }
+        
+    private:
+        friend class AnalysisRegistry;
+        std::pair<uint32_t, std::string> key;
+    };
+    
+    ///Process wide map from (input opId, configuration) to the analysis of that input.
+    ///Entries live as long as a CHOP holds them.
+    class AnalysisRegistry {
+    public:
+        static AnalysisRegistry& instance();
+        
+        ///Returns the analysis of the input for config, created if no one holds it.
+        ///When current is held only by the caller it moves to the new key instead,
+        ///so a lone CHOP changing its parameters keeps its analyzer and state.
+        std::shared_ptr<SharedAnalysis> acquire(uint32_t opId, const std::string& config, const std::shared_ptr<SharedAnalysis>& current);
+        
+        int getAnalysesNum();
+        
+    private:
+        AnalysisRegistry(){}
+        AnalysisRegistry(const AnalysisRegistry&) = delete;
+        AnalysisRegistry& operator=(const AnalysisRegistry&) = delete;
+        
+        typedef std::pair<uint32_t, std::string> Key;
+        
+        std::mutex _mutex;
+        std::map<Key, std::weak_ptr<SharedAnalysis>> _analyses;
+    };
+}
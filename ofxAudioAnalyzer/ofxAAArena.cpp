@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+#include "ofxAAArena.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+#include <iostream>
+
+namespace ofxaa {
+
+    Arena::Arena(){
+        _size = 0;
+        _rawBlock = NULL;
+        _block = NULL;
+    }
+
+    Arena::~Arena(){
+        free(_rawBlock);
+    }
+
+    void Arena::allocate(){
+        if (_block != NULL){
+            std::cout << "ofxAAArena: allocate() called twice" << std::endl;
+            return;
+        }
+        if (_size == 0){ return; }
+
+        _rawBlock = malloc(_size + ARENA_ALIGNMENT);
+        uintptr_t address = reinterpret_cast<uintptr_t>(_rawBlock);
+        address = (address + ARENA_ALIGNMENT - 1) & ~(uintptr_t)(ARENA_ALIGNMENT - 1);
+        _block = reinterpret_cast<char*>(address);
+        memset(_block, 0, _size);
+
+        for (auto& slot : _slots){
+            slot.attach(_block + slot.offset);
+        }
+    }
+}
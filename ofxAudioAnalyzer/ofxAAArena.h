@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+#pragma once
+
+#include <vector>
+#include <functional>
+#include <algorithm>
+
+#include "roguevector.h"
+
+#define ARENA_ALIGNMENT 64
+
+namespace ofxaa {
+
+    ///std::vector whose storage can be moved into an Arena block.
+    ///Until attached it behaves as a regular vector. Once attached it must keep its size:
+    ///a reallocation would give arena memory back to the heap.
+    ///Being a std::vector it can be bound directly to Essentia inputs and outputs.
+    template <typename T>
+    class ArenaVector : public essentia::RogueVector<T> {
+    public:
+        ArenaVector() : essentia::RogueVector<T>() {
+            this->_ownsMemory = true;
+        }
+        ArenaVector(const ArenaVector&) = delete;
+        ArenaVector& operator=(const ArenaVector&) = delete;
+
+        bool isAttached() const { return !this->_ownsMemory; }
+
+        ///Copies current values into data and keeps pointing there.
+        void attach(T* data){
+            size_t size = this->size();
+            std::copy(this->begin(), this->end(), data);
+            std::vector<T>().swap(*this);
+            this->setData(data);
+            this->setSize(size);
+            this->_ownsMemory = false;
+        }
+    };
+
+    ///Single aligned memory block holding the intermediate buffers of a Network.
+    ///Buffers are reserved in compute (topological) order and attached all at once by allocate().
+    class Arena {
+    public:
+        Arena();
+        ~Arena();
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        ///Registers buffer with its current size. Empty buffers are ignored.
+        template <typename T>
+        void reserve(ArenaVector<T>& buffer){
+            if (buffer.empty() || buffer.isAttached() || _block != NULL){ return; }
+            Slot slot;
+            slot.offset = _size;
+            slot.bytes = buffer.size() * sizeof(T);
+            slot.attach = [&buffer](void* ptr){ buffer.attach(static_cast<T*>(ptr)); };
+            _slots.push_back(slot);
+            _size += alignedBytes(slot.bytes);
+        }
+
+        ///Allocates the block and attaches every reserved buffer.
+        void allocate();
+
+        size_t getSize() const { return _size; }
+        int getBuffersNum() const { return (int)_slots.size(); }
+
+    private:
+        struct Slot {
+            size_t offset;
+            size_t bytes;
+            std::function<void(void*)> attach;
+        };
+
+        static size_t alignedBytes(size_t bytes){
+            return (bytes + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+        }
+
+        std::vector<Slot> _slots;
+        size_t _size;
+        void* _rawBlock;
+        char* _block;
+    };
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#include "ofxAAConstantQ.h"
+#include "ofxAARuntime.h"
+#include "ofxAATableCache.h"
+#include "fftw3.h"
+
+#include <tuple>
+#include <cmath>
+
+#define CONSTANT_Q_KERNEL_THRESHOLD 0.01 //-40dB
+
+using essentia::Real;
+using std::vector;
+using std::complex;
+
+namespace ofxaa {
+    
+    //MARK: - APPLY
+    void ConstantQKernel::apply(const complex<Real>* fft, Real* magnitudes) const {
+        const complex<Real>* w = weights.data();
+        for (int k=0; k<binsNum; k++){
+            const complex<Real>* row = w + rowOffsets[k];
+            const complex<Real>* x = fft + firstBins[k];
+            int n = rowOffsets[k+1] - rowOffsets[k];
+            Real re = 0.0, im = 0.0;
+            for (int j=0; j<n; j++){
+                re += x[j].real() * row[j].real() - x[j].imag() * row[j].imag();
+                im += x[j].real() * row[j].imag() + x[j].imag() * row[j].real();
+            }
+            magnitudes[k] = sqrt(re*re + im*im);
+        }
+    }
+    
+    //MARK: - BUILD
+    namespace {
+        
+        std::shared_ptr<ConstantQKernel> buildKernel(int samplerate, int framesize, int binsPerOctave, Real minFrequency, int binsNum){
+            auto kernel = std::make_shared<ConstantQKernel>();
+            kernel->samplerate = samplerate;
+            kernel->framesize = framesize;
+            kernel->binsPerOctave = binsPerOctave;
+            kernel->minFrequency = minFrequency;
+            kernel->rowOffsets.push_back(0);
+            
+            int N = framesize;
+            int spectrumSize = N/2 + 1;
+            double Q = 1.0 / (pow(2.0, 1.0 / binsPerOctave) - 1.0);
+            
+            fftwf_complex* temporal = fftwf_alloc_complex(N);
+            fftwf_complex* spectral = fftwf_alloc_complex(N);
+            fftwf_plan plan;
+            {
+                RuntimeLock lock(Runtime::instance().getMutex());
+                plan = fftwf_plan_dft_1d(N, temporal, spectral, FFTW_FORWARD, FFTW_ESTIMATE);
+            }
+            
+            for (int k=0; k<binsNum; k++){
+                double frequency = minFrequency * pow(2.0, double(k) / binsPerOctave);
+                if (frequency >= samplerate / 2.0){ break; }
+                
+                //Low bins are limited by the frame length.
+                int length = std::min(int(ceil(Q * samplerate / frequency)), N);
+                double windowSum = 0.0;
+                for (int n=0; n<length; n++){
+                    windowSum += 0.54 - 0.46 * cos(2.0 * M_PI * n / (length - 1));
+                }
+                std::fill((float*)temporal, (float*)(temporal + N), 0.0f);
+                for (int n=0; n<length; n++){
+                    int t = n - length/2;
+                    double window = (0.54 - 0.46 * cos(2.0 * M_PI * n / (length - 1))) / windowSum;
+                    double phase = 2.0 * M_PI * frequency * t / samplerate;
+                    int index = (t + N) % N;
+                    temporal[index][0] = window * cos(phase);
+                    temporal[index][1] = window * sin(phase);
+                }
+                fftwf_execute(plan);
+                
+                //Sum over the spectrum of X * conj(K) / N equals the kernel applied in time.
+                double peak = 0.0;
+                for (int j=0; j<spectrumSize; j++){
+                    peak = std::max(peak, (double)hypot(spectral[j][0], spectral[j][1]));
+                }
+                double threshold = peak * CONSTANT_Q_KERNEL_THRESHOLD;
+                int first = 0;
+                int last = spectrumSize - 1;
+                while (first < last && hypot(spectral[first][0], spectral[first][1]) < threshold){ first++; }
+                while (last > first && hypot(spectral[last][0], spectral[last][1]) < threshold){ last--; }
+                
+                kernel->firstBins.push_back(first);
+                for (int j=first; j<=last; j++){
+                    kernel->weights.push_back(complex<Real>(spectral[j][0] / N, -spectral[j][1] / N));
+                }
+                kernel->rowOffsets.push_back((int)kernel->weights.size());
+                kernel->centerFrequencies.push_back(frequency);
+            }
+            kernel->binsNum = (int)kernel->centerFrequencies.size();
+            
+            {
+                RuntimeLock lock(Runtime::instance().getMutex());
+                fftwf_destroy_plan(plan);
+            }
+            fftwf_free(temporal);
+            fftwf_free(spectral);
+            return kernel;
+        }
+    }
+    
+    std::shared_ptr<const ConstantQKernel> getConstantQKernel(int samplerate, int framesize, int binsPerOctave, Real minFrequency, int binsNum){
+        typedef std::tuple<int, int, int, Real, int> Key;
+        static TableCache<ConstantQKernel, Key> kernels;
+        
+        return kernels.get(Key(samplerate, framesize, binsPerOctave, minFrequency, binsNum), [=](){
+            return buildKernel(samplerate, framesize, binsPerOctave, minFrequency, binsNum);
+        });
+    }
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#pragma once
+
+#include <vector>
+#include <complex>
+#include <memory>
+
+#include "types.h"
+
+namespace ofxaa {
+    
+    ///Brown-Puckette constant-Q spectral kernels, applied to the FFT of a frame.
+    ///Each bin's kernel is the DFT of a Hamming windowed complex exponential, of length
+    ///Q*samplerate/f clamped to the frame size, centred on sample 0 to match the zero-phase frames
+    ///of the Network windowing. Kernel values below CONSTANT_Q_KERNEL_THRESHOLD of the bin's peak
+    ///are dropped, and the remaining values of a bin cover contiguous FFT bins (sparse CSR rows).
+    struct ConstantQKernel {
+        int samplerate;
+        int framesize;
+        int binsPerOctave;
+        essentia::Real minFrequency;
+        int binsNum;
+        
+        std::vector<int> rowOffsets;///binsNum+1 offsets into weights
+        std::vector<int> firstBins;///first FFT bin of each row
+        std::vector< std::complex<essentia::Real> > weights;///conjugated spectral kernels
+        std::vector<essentia::Real> centerFrequencies;
+        
+        int getSpectrumSize() const { return framesize/2 + 1; }
+        
+        ///magnitudes[k] = |sum of row k times fft|. fft must hold getSpectrumSize() values.
+        void apply(const std::complex<essentia::Real>* fft, essentia::Real* magnitudes) const;
+    };
+    
+    ///Returns the kernel for (samplerate, framesize, binsPerOctave, minFrequency), bins stop below Nyquist.
+    ///Kernels are shared by every Network of the process while any of them holds one.
+    std::shared_ptr<const ConstantQKernel> getConstantQKernel(int samplerate, int framesize, int binsPerOctave, essentia::Real minFrequency, int binsNum);
+}
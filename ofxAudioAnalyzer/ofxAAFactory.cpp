@@ -36,6 +36,7 @@ namespace ofxaa {
             silenceRateThresholds[i] = db2lin(thresholds_dB[i]/2.0);
         }
         
+        RuntimeLock lock(Runtime::instance().getMutex());
         AlgorithmFactory& factory = AlgorithmFactory::instance();
         
         switch (algorithmType) {
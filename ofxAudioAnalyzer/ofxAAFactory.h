@@ -26,6 +26,7 @@
 
 
 #include "ofxAAAlgorithmTypes.h"
+#include "ofxAARuntime.h"
 #include "algorithmfactory.h"
 
 #include "essentiamath.h"
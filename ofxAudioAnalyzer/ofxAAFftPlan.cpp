@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+#include "ofxAAFftPlan.h"
+#include "ofxAARuntime.h"
+#include "ofxAATableCache.h"
+
+#include <tuple>
+
+namespace ofxaa {
+    
+    namespace {
+        fftwf_plan makePlan(FftPlanType type, int size, unsigned flags){
+            //Planning arrays only: FFTW_ESTIMATE doesn't touch them, FFTW_MEASURE overwrites them.
+            float* real = fftwf_alloc_real(size);
+            fftwf_complex* complex = fftwf_alloc_complex(size/2 + 1);
+            fftwf_plan plan;
+            {
+                RuntimeLock lock(Runtime::instance().getMutex());
+                if (type == REAL_TO_COMPLEX_FFT){
+                    plan = fftwf_plan_dft_r2c_1d(size, real, complex, flags);
+                } else {
+                    plan = fftwf_plan_dft_c2r_1d(size, complex, real, flags);
+                }
+            }
+            fftwf_free(real);
+            fftwf_free(complex);
+            return plan;
+        }
+    }
+    
+    FftPlan::FftPlan(FftPlanType type, int size, bool measured){
+        this->type = type;
+        this->size = size;
+        this->isMeasured = measured;
+        plan = makePlan(type, size, measured ? FFTW_MEASURE : FFTW_ESTIMATE);
+    }
+    
+    FftPlan::~FftPlan(){
+        RuntimeLock lock(Runtime::instance().getMutex());
+        fftwf_destroy_plan(plan);
+    }
+    
+    std::shared_ptr<const FftPlan> getFftPlan(FftPlanType type, int size){
+        typedef std::tuple<int, int, bool> Key;
+        static TableCache<FftPlan, Key> plans;
+        
+        bool measured = Runtime::instance().getMeasuredPlanning();
+        return plans.get(Key((int)type, size, measured), [=](){
+            return std::make_shared<const FftPlan>(type, size, measured);
+        });
+    }
+    
+    void measureFft(FftPlanType type, int size){
+        fftwf_plan plan = makePlan(type, size, FFTW_MEASURE);
+        RuntimeLock lock(Runtime::instance().getMutex());
+        fftwf_destroy_plan(plan);
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "fftw3.h"
+
+namespace ofxaa {
+    
+    enum FftPlanType {
+        REAL_TO_COMPLEX_FFT,
+        COMPLEX_TO_REAL_FFT
+    };
+    
+    ///Out of place single precision FFTW plan, shared by every algorithm transforming the same size.
+    ///Executed on the caller's buffers with FFTW's new-array functions, which are thread safe.
+    ///Buffers must come from fftwf_alloc_real/fftwf_alloc_complex, so their alignment matches the planning.
+    struct FftPlan {
+        FftPlanType type;
+        int size;
+        bool isMeasured;
+        fftwf_plan plan;
+        
+        ///Measured plans are timed by FFTW_MEASURE, unless the FFTW wisdom already knows the size.
+        FftPlan(FftPlanType type, int size, bool measured = false);
+        ~FftPlan();
+        
+        ///size real samples to size/2+1 complex bins.
+        void execute(float* in, fftwf_complex* out) const { fftwf_execute_dft_r2c(plan, in, out); }
+        ///size/2+1 complex bins to size real samples, unscaled. Overwrites in.
+        void execute(fftwf_complex* in, float* out) const { fftwf_execute_dft_c2r(plan, in, out); }
+    };
+    
+    ///Returns the plan for (type, size). Planned under the Runtime lock,
+    ///measured if the Runtime measured planning is enabled.
+    std::shared_ptr<const FftPlan> getFftPlan(FftPlanType type, int size);
+    
+    ///Measures (type, size) into the FFTW wisdom and drops the plan. Later plans of that size,
+    ///Essentia's estimated ones included, are made from the wisdom instead of FFTW's estimate.
+    void measureFft(FftPlanType type, int size);
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#include "ofxAAFilterbank.h"
+#include "ofxAATableCache.h"
+
+#include <tuple>
+#include <cmath>
+#include <iostream>
+
+#define ERB_LOW_FREQUENCY 40.0 //GFCC default lowFrequencyBound
+#define ERB_EAR_Q 9.26449
+#define ERB_MIN_BW 24.7
+#define ERB_MIN_WEIGHT 1e-4 //-80dB, weights below are left out of the table
+
+using essentia::Real;
+using std::vector;
+
+namespace ofxaa {
+    
+    //MARK: - APPLY
+    void FilterbankTable::apply(const Real* spectrum, Real* bands) const {
+        const Real* w = weights.data();
+        for (int b=0; b<bandsNum; b++){
+            const Real* row = w + rowOffsets[b];
+            const Real* x = spectrum + firstBins[b];
+            int n = rowOffsets[b+1] - rowOffsets[b];
+            //Independent partial sums let the compiler keep several lanes busy.
+            Real s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+            int k = 0;
+            for (; k+4<=n; k+=4){
+                s0 += row[k] * x[k];
+                s1 += row[k+1] * x[k+1];
+                s2 += row[k+2] * x[k+2];
+                s3 += row[k+3] * x[k+3];
+            }
+            for (; k<n; k++){
+                s0 += row[k] * x[k];
+            }
+            bands[b] = (s0 + s1) + (s2 + s3);
+        }
+    }
+    
+    //MARK: - BUILD
+    namespace {
+        
+        ///Appends a dense row to the table, trimming the zero weights at both ends.
+        void appendRow(FilterbankTable& table, const vector<Real>& row){
+            int first = 0;
+            int last = (int)row.size() - 1;
+            while (first <= last && row[first] == 0.0){ first++; }
+            while (last >= first && row[last] == 0.0){ last--; }
+            if (first > last){
+                first = 0;
+                last = -1;
+            }
+            table.firstBins.push_back(first);
+            table.weights.insert(table.weights.end(), row.begin() + first, row.begin() + last + 1);
+            table.rowOffsets.push_back((int)table.weights.size());
+        }
+        
+        Real hzToMel(Real hz){ return 2595.0 * log10(1.0 + hz / 700.0); }
+        Real melToHz(Real mel){ return 700.0 * (pow(10.0, mel / 2595.0) - 1.0); }
+        
+        void buildMel(FilterbankTable& table){
+            int size = table.getSpectrumSize();
+            Real binWidth = (table.samplerate / 2.0) / (size - 1);
+            Real melHigh = hzToMel(table.samplerate / 2.0);
+            
+            vector<Real> edges(table.bandsNum + 2);
+            for (size_t i=0; i<edges.size(); i++){
+                edges[i] = melToHz(melHigh * i / (table.bandsNum + 1));
+            }
+            
+            vector<Real> row(size);
+            for (int b=0; b<table.bandsNum; b++){
+                Real low = hzToMel(edges[b]);
+                Real center = hzToMel(edges[b+1]);
+                Real high = hzToMel(edges[b+2]);
+                Real sum = 0.0;
+                for (int k=0; k<size; k++){
+                    Real mel = hzToMel(k * binWidth);
+                    Real w = 0.0;
+                    if (mel > low && mel <= center){
+                        w = (mel - low) / (center - low);
+                    } else if (mel > center && mel < high){
+                        w = (high - mel) / (high - center);
+                    }
+                    row[k] = w;
+                    sum += w;
+                }
+                if (sum > 0.0){
+                    for (auto& w : row){ w /= sum; }
+                }
+                table.centerFrequencies.push_back(edges[b+1]);
+                appendRow(table, row);
+            }
+        }
+        
+        void buildBark(FilterbankTable& table){
+            static const Real barkEdges[] = {0.0, 50.0, 100.0, 150.0, 200.0, 300.0, 400.0, 510.0, 630.0, 770.0, 920.0, 1080.0, 1270.0, 1480.0, 1720.0, 2000.0, 2320.0, 2700.0, 3150.0, 3700.0, 4400.0, 5300.0, 6400.0, 7700.0, 9500.0, 12000.0, 15500.0, 20500.0, 27000.0};
+            static const int maxBands = sizeof(barkEdges) / sizeof(Real) - 1;
+            if (table.bandsNum > maxBands){
+                std::cout << "ofxAAFilterbank: Bark filterbank has at most " << maxBands << " bands" << std::endl;
+                table.bandsNum = maxBands;
+            }
+            int size = table.getSpectrumSize();
+            Real binWidth = (table.samplerate / 2.0) / (size - 1);
+            
+            //Same bin selection as Essentia's FrequencyBands.
+            vector<Real> row(size);
+            for (int b=0; b<table.bandsNum; b++){
+                std::fill(row.begin(), row.end(), 0.0);
+                int startBin = int(barkEdges[b] / binWidth + 0.5);
+                int endBin = std::min(int(barkEdges[b+1] / binWidth + 0.5), size);
+                if (startBin < size){
+                    if (startBin == endBin){
+                        row[startBin] = 1.0;
+                    }
+                    for (int k=startBin; k<endBin; k++){
+                        row[k] = 1.0;
+                    }
+                }
+                table.centerFrequencies.push_back((barkEdges[b] + barkEdges[b+1]) / 2.0);
+                appendRow(table, row);
+            }
+        }
+        
+        void buildErb(FilterbankTable& table){
+            int size = table.getSpectrumSize();
+            Real binWidth = (table.samplerate / 2.0) / (size - 1);
+            Real low = ERB_LOW_FREQUENCY;
+            Real high = table.samplerate / 2.0;
+            Real q = ERB_EAR_Q * ERB_MIN_BW;
+            
+            vector<Real> row(size);
+            for (int b=0; b<table.bandsNum; b++){
+                //Centres equally spaced on the ERB scale, ascending.
+                int i = table.bandsNum - b;
+                Real cf = -q + exp(i * (log(low + q) - log(high + q)) / table.bandsNum) * (high + q);
+                Real bandwidth = 1.019 * (cf / ERB_EAR_Q + ERB_MIN_BW);
+                for (int k=0; k<size; k++){
+                    Real x = (k * binWidth - cf) / bandwidth;
+                    Real w = 1.0 / pow(1.0 + x*x, 2.0);
+                    row[k] = w < ERB_MIN_WEIGHT ? 0.0 : w;
+                }
+                table.centerFrequencies.push_back(cf);
+                appendRow(table, row);
+            }
+        }
+        
+        std::shared_ptr<const FilterbankTable> buildTable(FilterbankType type, int bandsNum, int samplerate, int framesize){
+            auto table = std::make_shared<FilterbankTable>();
+            table->type = type;
+            table->bandsNum = bandsNum;
+            table->samplerate = samplerate;
+            table->framesize = framesize;
+            table->rowOffsets.push_back(0);
+            
+            switch (type) {
+                case MEL_FILTERBANK:
+                    buildMel(*table);
+                    break;
+                case BARK_FILTERBANK:
+                    buildBark(*table);
+                    break;
+                case ERB_FILTERBANK:
+                    buildErb(*table);
+                    break;
+            }
+            return table;
+        }
+    }
+    
+    //MARK: - SHARED TABLES
+    std::shared_ptr<const FilterbankTable> getFilterbankTable(FilterbankType type, int bandsNum, int samplerate, int framesize){
+        typedef std::tuple<int, int, int, int> Key;
+        static TableCache<FilterbankTable, Key> tables;
+        
+        return tables.get(Key((int)type, bandsNum, samplerate, framesize), [=](){
+            return buildTable(type, bandsNum, samplerate, framesize);
+        });
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#pragma once
+
+#include <vector>
+#include <memory>
+
+#include "types.h"
+
+namespace ofxaa {
+    
+    enum FilterbankType {
+        MEL_FILTERBANK,///Triangular bands on the HTK mel scale, each band weights sum 1 (Essentia MelBands defaults).
+        BARK_FILTERBANK,///Rectangular bands on the Bark critical bands (Essentia BarkBands).
+        ERB_FILTERBANK///4th order gammatone magnitude responses on ERB spaced centres (Essentia ERBBands centres).
+    };
+    
+    ///Filterbank weights stored as a sparse CSR matrix, one row per band.
+    ///The non-zero weights of a row cover contiguous bins, so a row only stores its first bin
+    ///and its product with the spectrum is a plain dot product over contiguous memory.
+    struct FilterbankTable {
+        FilterbankType type;
+        int bandsNum;
+        int samplerate;
+        int framesize;
+        
+        std::vector<int> rowOffsets;///bandsNum+1 offsets into weights
+        std::vector<int> firstBins;///first spectrum bin of each row
+        std::vector<essentia::Real> weights;
+        std::vector<essentia::Real> centerFrequencies;
+        
+        int getSpectrumSize() const { return framesize/2 + 1; }
+        
+        ///bands[b] = sum of weights of row b times spectrum. spectrum must hold getSpectrumSize() values.
+        void apply(const essentia::Real* spectrum, essentia::Real* bands) const;
+    };
+    
+    ///Returns the table for (type, bandsNum, samplerate, framesize).
+    ///Tables are shared by every Network of the process while any of them holds one.
+    std::shared_ptr<const FilterbankTable> getFilterbankTable(FilterbankType type, int bandsNum, int samplerate, int framesize);
+}
@@ -51,6 +51,8 @@
 
 #define HFC_MAX_VALUE 8000.0
 #define ODD_TO_EVEN_MAX_VALUE 10.0
+#define SPECTRAL_TILT_MIN_VALUE -30.0 //dB per octave
+#define SPECTRAL_TILT_MAX_VALUE 10.0
 #define STRONG_PEAK_MAX_VALUE 150
 #define PITCH_YIN_FREQ_MAX_VALUE 4186.0 //C8
 
@@ -58,6 +60,10 @@
 
 #define HPCP_SIZE 12
 
+#define SPECTRAL_PEAKS_MAX_FREQUENCY 5000.0
+#define SPECTRAL_PEAKS_MAX_PEAKS 100
+#define HPCP_MAX_PEAKS 10000
+
 //TODO: Remove deprecated mfcc ?
 
 namespace ofxaa {
@@ -65,18 +71,130 @@ namespace ofxaa {
     Network::Network(int sr, int bufferSize){
         _framesize = bufferSize;
         _samplerate = sr;
+        _isProfiling = false;
+        _trace = NULL;
+        _frameIndex = 0;
+        _areOptionalDropped = false;
+        _computeProfile.name = "network";
+        _framePeriod = Real(bufferSize) / sr;
+        _hasHostFramePeriod = false;
         
         _audioSignal.resize(bufferSize);
         //_accumulatedAudioSignal.resize(bufferSize * ACCUMULATED_SIGNAL_MULTIPLIER, 0.0);
         
-        createAlgorithms();
+        {
+            //Factory and FFTW planner access, so Networks can be built from any thread.
+            RuntimeLock lock(Runtime::instance().getMutex());
+            if (Runtime::instance().getMeasuredPlanning()){
+                //Essentia's FFT then plans the frame from the measured wisdom.
+                measureFft(REAL_TO_COMPLEX_FFT, _framesize);
+            }
+            createAlgorithms();
+        }
+        groupAlgorithms();
+        layoutBuffers();
         connectAlgorithms();
+        for (auto a : algorithms){
+            a->saveDefaults();
+        }
     }
     
     Network::~Network(){
+        RuntimeLock lock(Runtime::instance().getMutex());
         deleteAlgorithms();
     }
     
+    void Network::reset(){
+        for (auto a : algorithms){
+            a->resetAlgorithm();
+        }
+        std::fill(_audioSignal.begin(), _audioSignal.end(), 0.0);
+        _areOptionalDropped = false;
+        _optionalActiveStates.assign(_optionalAlgorithms.size(), true);
+        _isProfiling = false;
+        for (auto& profile : _nodeProfiles){ profile.reset(); }
+        _computeProfile.reset();
+        _trace = NULL;
+        _frameIndex = 0;
+        _framePeriod = Real(_framesize) / _samplerate;
+        _hasHostFramePeriod = false;
+        applyFramePeriod();
+    }
+    
+    void Network::setFramePeriod(Real seconds){
+        if (seconds <= 0.0 || seconds > NETWORK_MAX_FRAME_PERIOD){ return; }
+        if (_hasHostFramePeriod){
+            //Dropped host frames make single hops longer.
+            _framePeriod += NETWORK_FRAME_PERIOD_SMOOTHING * (seconds - _framePeriod);
+        } else {
+            _framePeriod = seconds;
+            _hasHostFramePeriod = true;
+        }
+        applyFramePeriod();
+    }
+    
+    void Network::applyFramePeriod(){
+        tempo->setFramePeriod(_framePeriod);
+        chords->setFramePeriod(_framePeriod);
+        key->setFramePeriod(_framePeriod);
+    }
+    
+    void Network::addAlgorithm(ofxAABaseAlgorithm* algorithm, const string& name){
+        algorithms.push_back(algorithm);
+        NodeProfile profile;
+        profile.name = name;
+        _nodeProfiles.push_back(profile);
+    }
+    
+    void Network::groupAlgorithms(){
+        //Chords and key aren't rate reduced: their window and decay count frames. Between HPCP updates
+        //they take in the held HPCP, at 12 x templates operations per frame.
+        _tonalAlgorithms = {
+            pitchYinFFT, pitchSalience, constantQ,
+            spectralPeaksSet, spectralPeaks, dissonance, harmonicPeaks, harmonicDescriptors,
+            spectralPeaks_hpcp, hpcp, hpcp_entropy, hpcp_crest
+        };
+        _optionalAlgorithms = {
+            melBands, melBands_centralMoments, melBands_distributionShape, melBands_flatnessDb, melBands_crest,
+            erbBands, erbBands_centralMoments, erbBands_distributionShape, erbBands_flatnessDb, erbBands_crest,
+            barkBands, barkBands_centralMoments, barkBands_distributionShape, barkBands_flatnessDb, barkBands_crest,
+            spectralComplexity, strongPeak
+        };
+        _optionalActiveStates.assign(_optionalAlgorithms.size(), true);
+    }
+    
+    void Network::setTonalUpdateInterval(int interval){
+        interval = std::max(interval, 1);
+        for (auto a : _tonalAlgorithms){
+            a->updateInterval = interval;
+        }
+    }
+    
+    void Network::setOptionalDescriptorsDropped(bool dropped){
+        if (dropped == _areOptionalDropped){ return; }
+        _areOptionalDropped = dropped;
+        for (size_t i=0; i<_optionalAlgorithms.size(); i++){
+            if (dropped){
+                _optionalActiveStates[i] = _optionalAlgorithms[i]->isActive;
+                _optionalAlgorithms[i]->isActive = false;
+            } else {
+                _optionalAlgorithms[i]->isActive = _optionalActiveStates[i];
+            }
+        }
+    }
+    
+    void Network::setTonalFrameReduced(bool reduced){
+        pitchYinFFT->setReducedFrame(reduced);
+    }
+    
+    void Network::setProfiling(bool enabled){
+        if (enabled && !_isProfiling){
+            for (auto& profile : _nodeProfiles){ profile.reset(); }
+            _computeProfile.reset();
+        }
+        _isProfiling = enabled;
+    }
+    
     void Network::deleteAlgorithms(){
         for (auto a : algorithms){
             a->deleteAlgorithm();
@@ -92,316 +210,364 @@ namespace ofxaa {
         vector<float> distributionShapeMinValues { KURTOSIS_MIN_VALUE, SPREAD_MIN_VALUE, SKEWNESS_MIN_VALUE };
         vector<float> distributionShapeMaxValues { KURTOSIS_MAX_VALUE, SPREAD_MAX_VALUE, SKEWNESS_MAX_VALUE };
         
-        dcRemoval = new ofxAAOneVectorOutputAlgorithm(DCRemoval, sr, fs);
-        algorithms.push_back(dcRemoval);
+        dcRemoval = new ofxAAOneVectorOutputAlgorithm(DCRemoval, sr, fs, fs);
+        addAlgorithm(dcRemoval, "dcRemoval");
         
-        windowing = new ofxAAOneVectorOutputAlgorithm(Windowing, sr, fs);
-        algorithms.push_back(windowing);
+        ///Hann, normalized and zero phase, from a window shared by every Network of the format
+        windowing = new ofxAAWindowingAlgorithm(sr, fs);
+        addAlgorithm(windowing, "windowing");
         
-        spectrum = new ofxAAOneVectorOutputAlgorithm(Spectrum, sr, fs, (fs/2)+1);
+        fft = new ofxAAVectorComplexOutputAlgorithm(Fft, sr, fs, (fs/2)+1);
+        addAlgorithm(fft, "fft");
+        
+        ///Magnitude (outputValues) and power (outputValues_2) spectrum
+        spectrum = new ofxAASpectrumAlgorithm(sr, fs);
         spectrum->hasLogarithmicValues = true;
-        algorithms.push_back(spectrum);
+        addAlgorithm(spectrum, "spectrum");
+        
+        ///Cumulative power: band energies and roll-off read from it
+        energyIndex = new ofxAAEnergyIndexAlgorithm(sr, fs);
+        addAlgorithm(energyIndex, "energyIndex");
         
         //MARK: TEMPORAL
         rms = new ofxAASingleOutputAlgorithm(Rms, sr, fs);
         rms->hasLogarithmicValues = true;
-        algorithms.push_back(rms);
+        addAlgorithm(rms, "rms");
         
         power = new ofxAASingleOutputAlgorithm(InstantPower, sr, fs);
         power->hasLogarithmicValues = true;
-        algorithms.push_back(power);
+        addAlgorithm(power, "power");
         
         zeroCrossingRate = new ofxAASingleOutputAlgorithm(ZeroCrossingRate, sr, fs);
         zeroCrossingRate->isNormalizedByDefault = true;
-        algorithms.push_back(zeroCrossingRate);
+        addAlgorithm(zeroCrossingRate, "zeroCrossingRate");
         
         loudness = new ofxAASingleOutputAlgorithm(Loudness, sr, fs);
         loudness->maxEstimatedValue = LOUDNESS_MAX_VALUE;
-        algorithms.push_back(loudness);
+        addAlgorithm(loudness, "loudness");
         
         /*
          Only works at 44100 samplerate
         loudnessVickers = new ofxAASingleOutputAlgorithm(LoudnessVickers, sr, fs);
         loudnessVickers->hasDbValues = true;
-        algorithms.push_back(loudnessVickers);
+        addAlgorithm(loudnessVickers, "loudnessVickers");
         */
         
         silenceRate = new ofxAAOneVectorOutputAlgorithm(SilenceRate, sr, fs, 3);
         silenceRate->isNormalizedByDefault = true;
-        algorithms.push_back(silenceRate);
+        addAlgorithm(silenceRate, "silenceRate");
         
         dynamicComplexity = new ofxAAOneVectorOutputAlgorithm(DynamicComplexity, sr, fs, 2);
         dynamicComplexity->maxEstimatedValue = DYN_COMP_MAX_VALUE;
-//        algorithms.push_back(dynamicComplexity);
+//        addAlgorithm(dynamicComplexity, "dynamicComplexity");
         
         //MARK: SFX
         envelope = new ofxAAOneVectorOutputAlgorithm(Envelope, sr, fs);
-//        algorithms.push_back(envelope);
+//        addAlgorithm(envelope, "envelope");
         
         envelope_acummulated = new ofxAAOneVectorOutputAlgorithm(Envelope, sr, fs);
-//        algorithms.push_back(envelope_acummulated);
+//        addAlgorithm(envelope_acummulated, "envelope_acummulated");
         
         sfx_decrease = new ofxAASingleOutputAlgorithm(Decrease, sr, fs);
         sfx_decrease->hasLogarithmicValues = true;
-//        algorithms.push_back(sfx_decrease);
+//        addAlgorithm(sfx_decrease, "sfx_decrease");
         
         centralMoments = new ofxAAOneVectorOutputAlgorithm(CentralMoments, sr, fs);
-//        algorithms.push_back(centralMoments);
+//        addAlgorithm(centralMoments, "centralMoments");
         
         distributionShape = new ofxAADistributionShapeAlgorithm(sr, fs);
         distributionShape->setMinEstimatedValues(distributionShapeMinValues);
         distributionShape->setMaxEstimatedValues(distributionShapeMaxValues);
-//        algorithms.push_back(distributionShape);
+//        addAlgorithm(distributionShape, "distributionShape");
         
         logAttackTime = new ofxAAOneVectorOutputAlgorithm(LogAttackTime, sr, fs, 3);
-//        algorithms.push_back(logAttackTime);
+//        addAlgorithm(logAttackTime, "logAttackTime");
         
         strongDecay = new ofxAASingleOutputAlgorithm(StrongDecay, sr, fs);
         strongDecay->maxEstimatedValue = STRONG_DECAY_MAX_VALUE;
-//        algorithms.push_back(strongDecay);
+//        addAlgorithm(strongDecay, "strongDecay");
         
         flatnessSFX = new ofxAASingleOutputAlgorithm(FlatnessSFX, sr, fs);
         flatnessSFX->maxEstimatedValue = FLATNESS_SFX_MAX_VALUE;
-//        algorithms.push_back(flatnessSFX);
+//        addAlgorithm(flatnessSFX, "flatnessSFX");
         
         maxToTotal = new ofxAASingleOutputAlgorithm(MaxToTotal, sr, fs);
         maxToTotal->isNormalizedByDefault = true;
-//        algorithms.push_back(maxToTotal);
+//        addAlgorithm(maxToTotal, "maxToTotal");
         
         tcToTotal = new ofxAASingleOutputAlgorithm(TCToTotal, sr, fs);
         tcToTotal->isNormalizedByDefault = true;
-       // algorithms.push_back(tcToTotal);
+       // addAlgorithm(tcToTotal, "tcToTotal");
         
         derivativeSFX = new ofxAAOneVectorOutputAlgorithm(DerivativeSFX, sr, fs, 2);
-//        algorithms.push_back(derivativeSFX);
+//        addAlgorithm(derivativeSFX, "derivativeSFX");
         
         //MARK: PITCH
-        pitchYinFFT = new ofxAAOneVectorOutputAlgorithm(PitchYinFFT, sr, fs, 2);
+        pitchYinFFT = new ofxAAPitchYinFFTAlgorithm(sr, fs);
         pitchYinFFT->setMaxEstimatedValues({PITCH_YIN_FREQ_MAX_VALUE, 1.0});
-        algorithms.push_back(pitchYinFFT);
+        addAlgorithm(pitchYinFFT, "pitchYinFFT");
         
         pitchMelodia = new ofxAATwoVectorsOutputAlgorithm(PitchMelodia, sr, fs);
-//        algorithms.push_back(pitchMelodia); // NOT WORKING
+//        addAlgorithm(pitchMelodia, "pitchMelodia"); // NOT WORKING
         
         multiPitchKlapuri = new ofxAAVectorVectorOutputAlgorithm(MultiPitchKlapuri, sr, fs);
-//        algorithms.push_back(multiPitchKlapuri);
+//        addAlgorithm(multiPitchKlapuri, "multiPitchKlapuri");
         
         /* Not working: https://github.com/MTG/essentia/issues/835 :
         equalLoudness = new ofxAAOneVectorOutputAlgorithm(EqualLoudness, sr, fs);
-        algorithms.push_back(equalLoudness);
+        addAlgorithm(equalLoudness, "equalLoudness");
         
         multiPitchMelodia = new ofxAAVectorVectorOutputAlgorithm(MultiPitchMelodia, sr, fs);
-        algorithms.push_back(multiPitchMelodia);
+        addAlgorithm(multiPitchMelodia, "multiPitchMelodia");
         */
         
         
         predominantPitchMelodia = new ofxAATwoVectorsOutputAlgorithm(PredominantPitchMelodia, sr, fs);
-//        algorithms.push_back(predominantPitchMelodia); // NOT WORKING
+//        addAlgorithm(predominantPitchMelodia, "predominantPitchMelodia"); // NOT WORKING
         
         
         //MARK: SPECTRAL
-        nsgConstantQ = new ofxAANSGConstantQAlgorithm(NSGConstantQ, sr, fs);
-//        algorithms.push_back(nsgConstantQ); // HIGH CPU CONSUMING ALGORITHM
+        ///Sparse kernels on the shared FFT, instead of Essentia's NSGConstantQ
+        constantQ = new ofxAAConstantQAlgorithm(sr, fs);
+        constantQ->hasLogarithmicValues = true;
+        addAlgorithm(constantQ, "constantQ");
       
         //MARK: -MelBands
         /// Removed MFCC because it cant work with small buffers
 //        mfcc = new ofxAATwoVectorsOutputAlgorithm(Mfcc, sr, fs, MELBANDS_NUMBER_BANDS, 13);
 //        mfcc->hasLogarithmicValues = true;
-//        algorithms.push_back(mfcc);
-        
-//        melBands = new ofxAAOneVectorOutputAlgorithm(MelBands, sr, fs, MELBANDS_NUMBER_BANDS);
-//        melBands->hasLogarithmicValues = true;
-//        //algorithms.push_back(melBands);
-//
-//        melBands_centralMoments = new ofxAAOneVectorOutputAlgorithm(CentralMoments, sr, fs);
-//        ofxaa::configureCentralMoments(melBands_centralMoments->algorithm, "pdf", MELBANDS_NUMBER_BANDS-1);
-//        // algorithms.push_back(melBands_centralMoments);
-//
-//        melBands_distributionShape = new ofxAADistributionShapeAlgorithm(sr, fs);
-//        melBands_distributionShape->setMinEstimatedValues(distributionShapeMinValues);
-//        melBands_distributionShape->setMaxEstimatedValues(distributionShapeMaxValues);
-//        //algorithms.push_back(melBands_distributionShape);
-//
-//        melBands_flatnessDb = new ofxAASingleOutputAlgorithm(FlatnessDB, sr, fs);
-//        melBands_flatnessDb->isNormalizedByDefault = true;
-//        //algorithms.push_back(melBands_flatnessDb);
-//
-//        melBands_crest = new ofxAASingleOutputAlgorithm(Crest, sr, fs);
-//        melBands_crest->maxEstimatedValue = CREST_MAX_VALUE;
-//        // algorithms.push_back(melBands_crest);
+//        addAlgorithm(mfcc, "mfcc");
+        
+        melBands = new ofxAAFilterbankAlgorithm(MEL_FILTERBANK, MELBANDS_NUMBER_BANDS, sr, fs);
+        melBands->hasLogarithmicValues = true;
+        addAlgorithm(melBands, "melBands");
+        
+        melBands_centralMoments = new ofxAAOneVectorOutputAlgorithm(CentralMoments, sr, fs);
+        ofxaa::configureCentralMoments(melBands_centralMoments->algorithm, "pdf", MELBANDS_NUMBER_BANDS-1);
+        addAlgorithm(melBands_centralMoments, "melBands_centralMoments");
+        
+        melBands_distributionShape = new ofxAADistributionShapeAlgorithm(sr, fs);
+        melBands_distributionShape->setMinEstimatedValues(distributionShapeMinValues);
+        melBands_distributionShape->setMaxEstimatedValues(distributionShapeMaxValues);
+        addAlgorithm(melBands_distributionShape, "melBands_distributionShape");
+        
+        melBands_flatnessDb = new ofxAASingleOutputAlgorithm(FlatnessDB, sr, fs);
+        melBands_flatnessDb->isNormalizedByDefault = true;
+        addAlgorithm(melBands_flatnessDb, "melBands_flatnessDb");
+        
+        melBands_crest = new ofxAASingleOutputAlgorithm(Crest, sr, fs);
+        melBands_crest->maxEstimatedValue = CREST_MAX_VALUE;
+        addAlgorithm(melBands_crest, "melBands_crest");
         
         //MARK: -ERB Bands
-        gfcc = new ofxAATwoVectorsOutputAlgorithm(Gfcc, sr, fs, GFCC_NUMBER_BANDS, 13);
-        gfcc->maxEstimatedValue = GFCC_MAX_VALUE ;
-        gfcc->hasLogarithmicValues = true;
-        //algorithms.push_back(gfcc);
+        erbBands = new ofxAAFilterbankAlgorithm(ERB_FILTERBANK, GFCC_NUMBER_BANDS, sr, fs);
+        erbBands->maxEstimatedValue = GFCC_MAX_VALUE ;
+        erbBands->hasLogarithmicValues = true;
+        addAlgorithm(erbBands, "erbBands");
         
         erbBands_centralMoments = new ofxAAOneVectorOutputAlgorithm(CentralMoments, sr, fs);
         ofxaa::configureCentralMoments(erbBands_centralMoments->algorithm, "pdf", GFCC_NUMBER_BANDS-1);
-        //algorithms.push_back(erbBands_centralMoments);
+        addAlgorithm(erbBands_centralMoments, "erbBands_centralMoments");
         
         erbBands_distributionShape = new ofxAADistributionShapeAlgorithm(sr, fs);
         erbBands_distributionShape->setMinEstimatedValues(distributionShapeMinValues);
         erbBands_distributionShape->setMaxEstimatedValues(distributionShapeMaxValues);
-        //algorithms.push_back(erbBands_distributionShape);
+        addAlgorithm(erbBands_distributionShape, "erbBands_distributionShape");
         
         erbBands_flatnessDb = new ofxAASingleOutputAlgorithm(FlatnessDB, sr, fs);
         erbBands_flatnessDb->isNormalizedByDefault = true;
-        //algorithms.push_back(erbBands_flatnessDb);
+        addAlgorithm(erbBands_flatnessDb, "erbBands_flatnessDb");
         
         erbBands_crest = new ofxAASingleOutputAlgorithm(Crest, sr, fs);
         erbBands_crest->maxEstimatedValue = CREST_MAX_VALUE;
-        //algorithms.push_back(erbBands_crest);
+        addAlgorithm(erbBands_crest, "erbBands_crest");
         
         //MARK: -BarkBands
-        barkBands = new ofxAAOneVectorOutputAlgorithm(BarkBands, sr, fs, BARKBANDS_NUMBER_BANDS);
+        barkBands = new ofxAAFilterbankAlgorithm(BARK_FILTERBANK, BARKBANDS_NUMBER_BANDS, sr, fs);
         barkBands->hasLogarithmicValues = true;
-//        algorithms.push_back(barkBands);
+        addAlgorithm(barkBands, "barkBands");
         
         barkBands_centralMoments = new ofxAAOneVectorOutputAlgorithm(CentralMoments, sr, fs);
         ofxaa::configureCentralMoments(barkBands_centralMoments->algorithm, "pdf", BARKBANDS_NUMBER_BANDS-1);
-//        algorithms.push_back(barkBands_centralMoments);
+        addAlgorithm(barkBands_centralMoments, "barkBands_centralMoments");
         
         barkBands_distributionShape = new ofxAADistributionShapeAlgorithm(sr, fs);
         barkBands_distributionShape->setMinEstimatedValues(distributionShapeMinValues);
         barkBands_distributionShape->setMaxEstimatedValues(distributionShapeMaxValues);
-//        algorithms.push_back(barkBands_distributionShape);
+        addAlgorithm(barkBands_distributionShape, "barkBands_distributionShape");
         
         barkBands_flatnessDb = new ofxAASingleOutputAlgorithm(FlatnessDB, sr, fs);
         barkBands_flatnessDb->isNormalizedByDefault = true;
-//        algorithms.push_back(barkBands_flatnessDb);
+        addAlgorithm(barkBands_flatnessDb, "barkBands_flatnessDb");
         
         barkBands_crest = new ofxAASingleOutputAlgorithm(Crest, sr, fs);
         barkBands_crest->maxEstimatedValue = CREST_MAX_VALUE;
-//        algorithms.push_back(barkBands_crest);
-        
-        unaryOperator_square = new ofxAAOneVectorOutputAlgorithm(UnaryOperator, sr, fs);
-        algorithms.push_back(unaryOperator_square);
+        addAlgorithm(barkBands_crest, "barkBands_crest");
         
         //MARK: -ERB
-        ebr_low = new ofxAASingleOutputAlgorithm(EnergyBand, sr, fs);
-        ofxaa::configureEnergyBand(ebr_low->algorithm, 20.0, 150.0);
+        ebr_low = new ofxAAEnergyBandAlgorithm(sr, fs, 20.0, 150.0);
         ebr_low->maxEstimatedValue = ENERGY_MAX_VALUE;
         ebr_low->hasLogarithmicValues = true;
-        algorithms.push_back(ebr_low);
+        addAlgorithm(ebr_low, "ebr_low");
         
-        ebr_mid_low = new ofxAASingleOutputAlgorithm(EnergyBand, sr, fs);
-        ofxaa::configureEnergyBand(ebr_mid_low->algorithm, 150.0, 800.0);
+        ebr_mid_low = new ofxAAEnergyBandAlgorithm(sr, fs, 150.0, 800.0);
         ebr_mid_low->maxEstimatedValue = ENERGY_MAX_VALUE;
         ebr_mid_low->hasLogarithmicValues = true;
-        algorithms.push_back(ebr_mid_low);
+        addAlgorithm(ebr_mid_low, "ebr_mid_low");
         
-        ebr_mid_hi = new ofxAASingleOutputAlgorithm(EnergyBand, sr, fs);
-        ofxaa::configureEnergyBand(ebr_mid_hi->algorithm, 800.0, 4000.0);
+        ebr_mid_hi = new ofxAAEnergyBandAlgorithm(sr, fs, 800.0, 4000.0);
         ebr_mid_hi->maxEstimatedValue = ENERGY_MAX_VALUE;
         ebr_mid_hi->hasLogarithmicValues = true;
-        algorithms.push_back(ebr_mid_hi);
+        addAlgorithm(ebr_mid_hi, "ebr_mid_hi");
         
-        ebr_hi = new ofxAASingleOutputAlgorithm(EnergyBand, sr, fs);
-        ofxaa::configureEnergyBand(ebr_hi->algorithm, 4.000, 20.000);
+        ebr_hi = new ofxAAEnergyBandAlgorithm(sr, fs, 4000.0, 20000.0);
         ebr_hi->maxEstimatedValue = ENERGY_MAX_VALUE;
         ebr_hi->hasLogarithmicValues = true;
-        algorithms.push_back(ebr_hi);
+        addAlgorithm(ebr_hi, "ebr_hi");
+        
+        energyBands = new ofxAAEnergyBandsAlgorithm(sr, fs);
+        energyBands->maxEstimatedValue = ENERGY_MAX_VALUE;
+        energyBands->hasLogarithmicValues = true;
+        addAlgorithm(energyBands, "energyBands");
         
         //MARK: -Spectral Descriptors
         spectral_decrease = new ofxAASingleOutputAlgorithm(Decrease, sr, fs);
         ofxaa::configureDecrease(spectral_decrease->algorithm, sr/2);
         spectral_decrease->hasLogarithmicValues = true;
-        //algorithms.push_back(spectral_decrease);
+        //addAlgorithm(spectral_decrease, "spectral_decrease");
         
         spectral_centroid = new ofxAASingleOutputAlgorithm(Centroid, sr, fs);
         ofxaa::configureCentroid(spectral_centroid->algorithm, sr/2);
         spectral_centroid->maxEstimatedValue = sr/4;
-        algorithms.push_back(spectral_centroid);
+        addAlgorithm(spectral_centroid, "spectral_centroid");
         
-        rollOff = new ofxAASingleOutputAlgorithm(RollOff, sr, fs);
+        rollOff = new ofxAARollOffAlgorithm(sr, fs);
         rollOff->maxEstimatedValue = sr/2;
-        algorithms.push_back(rollOff);
+        addAlgorithm(rollOff, "rollOff");
         
         spectral_entropy = new ofxAASingleOutputAlgorithm(Entropy, sr, fs);
         spectral_entropy->maxEstimatedValue = ENTROPY_MAX_VALUE;
-        algorithms.push_back(spectral_entropy);
+        addAlgorithm(spectral_entropy, "spectral_entropy");
         
-        spectral_energy = new ofxAASingleOutputAlgorithm(Energy, sr, fs);
+        spectral_energy = new ofxAAEnergyBandAlgorithm(sr, fs, 0.0, sr/2.0);
         spectral_energy->maxEstimatedValue = ENERGY_MAX_VALUE;
-        algorithms.push_back(spectral_energy);
+        addAlgorithm(spectral_energy, "spectral_energy");
         
         hfc = new ofxAASingleOutputAlgorithm(Hfc, sr, fs);
         hfc->maxEstimatedValue = HFC_MAX_VALUE;
-        algorithms.push_back(hfc);
+        addAlgorithm(hfc, "hfc");
         
         spectral_flux = new ofxAASingleOutputAlgorithm(Flux, sr, fs);
         spectral_flux->isNormalizedByDefault = true;
-        algorithms.push_back(spectral_flux);
+        addAlgorithm(spectral_flux, "spectral_flux");
         
         strongPeak = new ofxAASingleOutputAlgorithm(StrongPeak, sr, fs);
         strongPeak->maxEstimatedValue = STRONG_PEAK_MAX_VALUE;
-        algorithms.push_back(strongPeak);
+        addAlgorithm(strongPeak, "strongPeak");
         
         spectralComplexity = new ofxAASingleOutputAlgorithm(SpectralComplexity, sr, fs);
         spectralComplexity->maxEstimatedValue = SPECTRAL_COMPLEXITY_MAX_VALUE;
-        algorithms.push_back(spectralComplexity);
+        addAlgorithm(spectralComplexity, "spectralComplexity");
         
         pitchSalience = new ofxAASingleOutputAlgorithm(PitchSalience, sr, fs);
         pitchSalience->isNormalizedByDefault = true;
-        algorithms.push_back(pitchSalience);
+        addAlgorithm(pitchSalience, "pitchSalience");
         
         spectral_centralMoments = new ofxAAOneVectorOutputAlgorithm(CentralMoments, sr, fs);
         ofxaa::configureCentralMoments(spectral_centralMoments->algorithm, "pdf", sr/2);
-        //algorithms.push_back(spectral_centralMoments);
+        //addAlgorithm(spectral_centralMoments, "spectral_centralMoments");
         
         spectral_distributionShape = new ofxAADistributionShapeAlgorithm(sr, fs);
         spectral_distributionShape->setMinEstimatedValues(distributionShapeMinValues);
         spectral_distributionShape->setMaxEstimatedValues(distributionShapeMaxValues);
-        //algorithms.push_back(spectral_distributionShape);
+        //addAlgorithm(spectral_distributionShape, "spectral_distributionShape");
         
-        spectralPeaks = new ofxAATwoVectorsOutputAlgorithm(SpectralPeaks, sr, fs);
-        algorithms.push_back(spectralPeaks);
+        ///Single peak pass, superset of the spectralPeaks and spectralPeaks_hpcp views
+        spectralPeaksSet = new ofxAASpectralPeaksAlgorithm(sr, fs, 0.0, SPECTRAL_PEAKS_MAX_FREQUENCY, 0.0, HPCP_MAX_PEAKS);
+        addAlgorithm(spectralPeaksSet, "spectralPeaksSet");
         
-        dissonance = new ofxAASingleOutputAlgorithm(Dissonance, sr, fs);
+        ///Essentia SpectralPeaks defaults, without the DC bin HarmonicPeaks rejects
+        spectralPeaks = new ofxAAPeaksViewAlgorithm(sr, fs, 1.0, SPECTRAL_PEAKS_MAX_FREQUENCY, 0.0, SPECTRAL_PEAKS_MAX_PEAKS, true);
+        addAlgorithm(spectralPeaks, "spectralPeaks");
+        
+        dissonance = new ofxAADissonanceAlgorithm(sr, fs);
         dissonance->isNormalizedByDefault = true;
-        algorithms.push_back(dissonance);
+        addAlgorithm(dissonance, "dissonance");
         
         harmonicPeaks = new ofxAATwoVectorsOutputAlgorithm(HarmonicPeaks, sr, fs);
-        algorithms.push_back(harmonicPeaks);
+        addAlgorithm(harmonicPeaks, "harmonicPeaks");
+        
+        ///Inharmonicity, OddToEven, Tristimulus, tilt and energy in one pass
+        harmonicDescriptors = new ofxAAHarmonicDescriptorsAlgorithm(sr, fs);
+        addAlgorithm(harmonicDescriptors, "harmonicDescriptors");
         
-        inharmonicity = new ofxAASingleOutputAlgorithm(Inharmonicity, sr, fs);
+        inharmonicity = harmonicDescriptors->inharmonicity;
         inharmonicity->isNormalizedByDefault = true;
-        algorithms.push_back(inharmonicity);
         
-        oddToEven = new ofxAASingleOutputAlgorithm(OddToEven, sr, fs);
+        oddToEven = harmonicDescriptors->oddToEven;
         oddToEven->maxEstimatedValue = ODD_TO_EVEN_MAX_VALUE;
-        algorithms.push_back(oddToEven);
         
-        tristimulus = new ofxAAOneVectorOutputAlgorithm(Tristimulus, sr, fs, 3);
+        tristimulus = harmonicDescriptors->tristimulus;
         tristimulus->isNormalizedByDefault = true;
-        //algorithms.push_back(tristimulus);
+        
+        harmonicSpectralTilt = harmonicDescriptors->spectralTilt;
+        harmonicSpectralTilt->minEstimatedValue = SPECTRAL_TILT_MIN_VALUE;
+        harmonicSpectralTilt->maxEstimatedValue = SPECTRAL_TILT_MAX_VALUE;
+        
+        harmonicEnergy = harmonicDescriptors->harmonicEnergy;
+        harmonicEnergy->maxEstimatedValue = ENERGY_MAX_VALUE;
+        harmonicEnergy->hasLogarithmicValues = true;
         
    
         //MARK: TONAL
         //src: tonalextractor.cpp
-        spectralPeaks_hpcp = new ofxAATwoVectorsOutputAlgorithm(SpectralPeaks, sr, fs);
-        ofxaa::configureSpectralPeaks(spectralPeaks_hpcp->algorithm, 0.00001, 5000.0, 10000, 40.0, "magnitude");
-        // algorithms.push_back(spectralPeaks_hpcp);
+        spectralPeaks_hpcp = new ofxAAPeaksViewAlgorithm(sr, fs, 40.0, SPECTRAL_PEAKS_MAX_FREQUENCY, 0.00001, HPCP_MAX_PEAKS, false);
+        addAlgorithm(spectralPeaks_hpcp, "spectralPeaks_hpcp");
         
         hpcp = new ofxAAOneVectorOutputAlgorithm(Hpcp, sr, fs, HPCP_SIZE);
         ofxaa::configureHPCP(hpcp->algorithm, true, 500.0, 0, 5000.0, false, 40.0, false, "unitMax", 440, HPCP_SIZE, "squaredCosine", 1.0);
         hpcp->isNormalizedByDefault = true;
-        // algorithms.push_back(hpcp);
+        addAlgorithm(hpcp, "hpcp");
         
         hpcp_entropy = new ofxAASingleOutputAlgorithm(Entropy, sr, fs);
         hpcp_entropy->maxEstimatedValue = ENTROPY_MAX_VALUE;
-        //algorithms.push_back(hpcp_entropy);
+        addAlgorithm(hpcp_entropy, "hpcp_entropy");
         
         hpcp_crest = new ofxAASingleOutputAlgorithm(Crest, sr, fs);
         hpcp_crest->maxEstimatedValue = CREST_MAX_VALUE;
-        //algorithms.push_back(hpcp_crest);
+        addAlgorithm(hpcp_crest, "hpcp_crest");
+        
+        ///Running window of HPCP frames, instead of Essentia's ChordsDetection on a copied pcp
+        chords = new ofxAAChordsAlgorithm(sr, fs);
+        chords->setMaxEstimatedValues({CHORDS_NUMBER - 1, 1.0});
+        addAlgorithm(chords, "chords");
+        
+        key = new ofxAAKeyAlgorithm(sr, fs);
+        key->setMaxEstimatedValues({KEYS_NUMBER - 1, 1.0, 1.0});
+        addAlgorithm(key, "key");
+        
+        onsets = new ofxAAOnsetsAlgorithm(fft, sr, fs);
+        addAlgorithm(onsets, "onsets");
         
-        chordsDetection = new ofxAATwoTypesVectorOutputAlgorithm(ChordsDetection, sr, fs);
-        // algorithms.push_back(chordsDetection);
+        ///Periodicity of the onsets detection function
+        tempo = new ofxAATempoAlgorithm(sr, fs);
+        tempo->setMaxEstimatedValues({TEMPO_MAX_BPM, 1.0});
+        addAlgorithm(tempo, "tempo");
         
-        onsets = new ofxAAOnsetsAlgorithm(windowing, sr, fs);
-        algorithms.push_back(onsets);
+        beatTracker = new ofxAABeatTrackerAlgorithm(sr, fs);
+        beatTracker->isNormalizedByDefault = true;
+        addAlgorithm(beatTracker, "beatTracker");
+    }
+    
+    //MARK: - LAYOUT BUFFERS
+    ///Places the input signal and every fixed-size output in one arena block, following the compute order.
+    ///Must run before connectAlgorithms(): some outputs are bound to single vector elements.
+    void Network::layoutBuffers(){
+        _arena.reserve(_audioSignalBuffer);
+        for (auto a : algorithms){
+            a->reserveBuffers(_arena);
+        }
+        _arena.allocate();
     }
     
     //MARK: - CONNECT ALGORITHMS
@@ -410,11 +576,14 @@ namespace ofxaa {
         dcRemoval->algorithm->input("signal").set(_audioSignal);
         dcRemoval->algorithm->output("signal").set(dcRemoval->outputValues);
         
-        windowing->algorithm->input("frame").set(dcRemoval->outputValues);
-        windowing->algorithm->output("frame").set(windowing->outputValues);
+        windowing->setFrameInput(dcRemoval->outputValues);
+        
+        fft->algorithm->input("frame").set(windowing->outputValues);
+        fft->algorithm->output("fft").set(fft->complexValues);
         
-        spectrum->algorithm->input("frame").set(windowing->outputValues);
-        spectrum->algorithm->output("spectrum").set(spectrum->outputValues);
+        spectrum->setFftInput(fft->complexValues);
+        
+        energyIndex->setPowerSpectrumInput(spectrum->outputValues_2);
         
         //MARK: TEMPORAL
         rms->algorithm->input("array").set(dcRemoval->outputValues);
@@ -487,9 +656,7 @@ namespace ofxaa {
          */
         //MARK: PITCH
         //source: standard_pitchdemo.cpp
-        pitchYinFFT->algorithm->input("spectrum").set(spectrum->outputValues);
-        pitchYinFFT->algorithm->output("pitch").set(pitchYinFFT->outputValues[0]);
-        pitchYinFFT->algorithm->output("pitchConfidence").set(pitchYinFFT->outputValues[1]);
+        pitchYinFFT->setPowerSpectrumInput(spectrum->outputValues_2);
         
         pitchMelodia->algorithm->input("signal").set(dcRemoval->outputValues);
         pitchMelodia->algorithm->output("pitch").set(pitchMelodia->outputValues);
@@ -512,38 +679,32 @@ namespace ofxaa {
         
         //MARK: SPECTRAL
         //Essentia source: FreesoundLowLevelDescriptors.cpp
-        nsgConstantQ->algorithm->input("frame").set(windowing->outputValues);
-        nsgConstantQ->algorithm->output("constantq").set(nsgConstantQ->constantq);
-        nsgConstantQ->algorithm->output("constantqdc").set(nsgConstantQ->constantqdc);
-        nsgConstantQ->algorithm->output("constantqnf").set(nsgConstantQ->constantqnf);
+        constantQ->setFftInput(fft->complexValues);
         //MARK: -MelBands
 //        mfcc->algorithm->input("spectrum").set(spectrum->outputValues);
 //        mfcc->algorithm->output("bands").set(mfcc->outputValues);
 //        mfcc->algorithm->output("mfcc").set(mfcc->outputValues_2);
         
-//        melBands->algorithm->input("spectrum").set(spectrum->outputValues);
-//        melBands->algorithm->output("bands").set(melBands->outputValues);
-//        
-//        melBands_centralMoments->algorithm->input("array").set(melBands->outputValues);
-//        melBands_centralMoments->algorithm->output("centralMoments").set(melBands_centralMoments->outputValues);
-//        
-//        melBands_distributionShape->algorithm->input("centralMoments").set(melBands_centralMoments->outputValues);
-//        melBands_distributionShape->algorithm->output("kurtosis").set(melBands_distributionShape->outputValues[0]);
-//        melBands_distributionShape->algorithm->output("spread").set(melBands_distributionShape->outputValues[1]);
-//        melBands_distributionShape->algorithm->output("skewness").set(melBands_distributionShape->outputValues[2]);
-//        
-//        melBands_flatnessDb->algorithm->input("array").set(melBands->outputValues);
-//        melBands_flatnessDb->algorithm->output("flatnessDB").set(melBands_flatnessDb->outputValue);
-//        
-//        melBands_crest->algorithm->input("array").set(melBands->outputValues);
-//        melBands_crest->algorithm->output("crest").set(melBands_crest->outputValue);
+        melBands->setPowerSpectrumInput(spectrum->outputValues_2);
+        
+        melBands_centralMoments->algorithm->input("array").set(melBands->outputValues);
+        melBands_centralMoments->algorithm->output("centralMoments").set(melBands_centralMoments->outputValues);
+        
+        melBands_distributionShape->algorithm->input("centralMoments").set(melBands_centralMoments->outputValues);
+        melBands_distributionShape->algorithm->output("kurtosis").set(melBands_distributionShape->outputValues[0]);
+        melBands_distributionShape->algorithm->output("spread").set(melBands_distributionShape->outputValues[1]);
+        melBands_distributionShape->algorithm->output("skewness").set(melBands_distributionShape->outputValues[2]);
+        
+        melBands_flatnessDb->algorithm->input("array").set(melBands->outputValues);
+        melBands_flatnessDb->algorithm->output("flatnessDB").set(melBands_flatnessDb->outputValue);
+        
+        melBands_crest->algorithm->input("array").set(melBands->outputValues);
+        melBands_crest->algorithm->output("crest").set(melBands_crest->outputValue);
         
         //MARK: -ERB Bands
-        gfcc->algorithm->input("spectrum").set(spectrum->outputValues);
-        gfcc->algorithm->output("bands").set(gfcc->outputValues);
-        gfcc->algorithm->output("gfcc").set(gfcc->outputValues_2);
+        erbBands->setPowerSpectrumInput(spectrum->outputValues_2);
         
-        erbBands_centralMoments->algorithm->input("array").set(gfcc->outputValues);
+        erbBands_centralMoments->algorithm->input("array").set(erbBands->outputValues);
         erbBands_centralMoments->algorithm->output("centralMoments").set(erbBands_centralMoments->outputValues);
         
         erbBands_distributionShape->algorithm->input("centralMoments").set(erbBands_centralMoments->outputValues);
@@ -551,15 +712,14 @@ namespace ofxaa {
         erbBands_distributionShape->algorithm->output("spread").set(erbBands_distributionShape->outputValues[1]);
         erbBands_distributionShape->algorithm->output("skewness").set(erbBands_distributionShape->outputValues[2]);
         
-        erbBands_flatnessDb->algorithm->input("array").set(gfcc->outputValues);
+        erbBands_flatnessDb->algorithm->input("array").set(erbBands->outputValues);
         erbBands_flatnessDb->algorithm->output("flatnessDB").set(erbBands_flatnessDb->outputValue);
         
-        erbBands_crest->algorithm->input("array").set(gfcc->outputValues);
+        erbBands_crest->algorithm->input("array").set(erbBands->outputValues);
         erbBands_crest->algorithm->output("crest").set(erbBands_crest->outputValue);
         
         //MARK: -BarkBands
-        barkBands->algorithm->input("spectrum").set(spectrum->outputValues);
-        barkBands->algorithm->output("bands").set(barkBands->outputValues);
+        barkBands->setPowerSpectrumInput(spectrum->outputValues_2);
         
         barkBands_centralMoments->algorithm->input("array").set(barkBands->outputValues);
         barkBands_centralMoments->algorithm->output("centralMoments").set(barkBands_centralMoments->outputValues);
@@ -576,36 +736,29 @@ namespace ofxaa {
         barkBands_crest->algorithm->output("crest").set(barkBands_crest->outputValue);
         
         //MARK: -ERB
-        ebr_low->algorithm->input("spectrum").set(spectrum->outputValues);
-        ebr_low->algorithm->output("energyBand").set(ebr_low->outputValue);
+        ebr_low->setEnergyIndexInput(energyIndex);
         
-        ebr_mid_low->algorithm->input("spectrum").set(spectrum->outputValues);
-        ebr_mid_low->algorithm->output("energyBand").set(ebr_mid_low->outputValue);
+        ebr_mid_low->setEnergyIndexInput(energyIndex);
         
-        ebr_mid_hi->algorithm->input("spectrum").set(spectrum->outputValues);
-        ebr_mid_hi->algorithm->output("energyBand").set(ebr_mid_hi->outputValue);
+        ebr_mid_hi->setEnergyIndexInput(energyIndex);
         
-        ebr_hi->algorithm->input("spectrum").set(spectrum->outputValues);
-        ebr_hi->algorithm->output("energyBand").set(ebr_hi->outputValue);
+        ebr_hi->setEnergyIndexInput(energyIndex);
         
-        //MARK: -Spectral Descriptors
-        unaryOperator_square->algorithm->input("array").set(spectrum->outputValues);
-        unaryOperator_square->algorithm->output("array").set(unaryOperator_square->outputValues);
+        energyBands->setInputs(spectrum->outputValues_2, energyIndex);
         
-        spectral_decrease->algorithm->input("array").set(unaryOperator_square->outputValues);
+        //MARK: -Spectral Descriptors
+        spectral_decrease->algorithm->input("array").set(spectrum->outputValues_2);
         spectral_decrease->algorithm->output("decrease").set(spectral_decrease->outputValue);
         
-        spectral_centroid->algorithm->input("array").set(unaryOperator_square->outputValues);
+        spectral_centroid->algorithm->input("array").set(spectrum->outputValues_2);
         spectral_centroid->algorithm->output("centroid").set(spectral_centroid->outputValue);
         
-        rollOff->algorithm->input("spectrum").set(spectrum->outputValues);
-        rollOff->algorithm->output("rollOff").set(rollOff->outputValue);
+        rollOff->setEnergyIndexInput(energyIndex);
         
         spectral_entropy->algorithm->input("array").set(spectrum->outputValues);
         spectral_entropy->algorithm->output("entropy").set(spectral_entropy->outputValue);
         
-        spectral_energy->algorithm->input("array").set(spectrum->outputValues);
-        spectral_energy->algorithm->output("energy").set(spectral_energy->outputValue);
+        spectral_energy->setEnergyIndexInput(energyIndex);
         
         hfc->algorithm->input("spectrum").set(spectrum->outputValues);
         hfc->algorithm->output("hfc").set(hfc->outputValue);
@@ -630,13 +783,10 @@ namespace ofxaa {
         spectral_distributionShape->algorithm->output("spread").set(spectral_distributionShape->outputValues[1]);
         spectral_distributionShape->algorithm->output("skewness").set(spectral_distributionShape->outputValues[2]);
         
-        spectralPeaks->algorithm->input("spectrum").set(spectrum->outputValues);
-        spectralPeaks->algorithm->output("frequencies").set(spectralPeaks->outputValues);
-        spectralPeaks->algorithm->output("magnitudes").set(spectralPeaks->outputValues_2);
+        spectralPeaksSet->setSpectrumInput(spectrum->outputValues);
+        spectralPeaks->setPeaksInput(spectralPeaksSet);
         
-        dissonance->algorithm->input("frequencies").set(spectralPeaks->outputValues);
-        dissonance->algorithm->input("magnitudes").set(spectralPeaks->outputValues_2);
-        dissonance->algorithm->output("dissonance").set(dissonance->outputValue);
+        dissonance->setPeaksInput(spectralPeaks->outputValues, spectralPeaks->outputValues_2);
         
         harmonicPeaks->algorithm->input("frequencies").set(spectralPeaks->outputValues);
         harmonicPeaks->algorithm->input("magnitudes").set(spectralPeaks->outputValues_2);
@@ -644,22 +794,10 @@ namespace ofxaa {
         harmonicPeaks->algorithm->output("harmonicFrequencies").set(harmonicPeaks->outputValues);
         harmonicPeaks->algorithm->output("harmonicMagnitudes").set(harmonicPeaks->outputValues_2);
         
-        inharmonicity->algorithm->input("frequencies").set(harmonicPeaks->outputValues);
-        inharmonicity->algorithm->input("magnitudes").set(harmonicPeaks->outputValues_2);
-        inharmonicity->algorithm->output("inharmonicity").set(inharmonicity->outputValue);
-        
-        oddToEven->algorithm->input("frequencies").set(harmonicPeaks->outputValues);
-        oddToEven->algorithm->input("magnitudes").set(harmonicPeaks->outputValues_2);
-        oddToEven->algorithm->output("oddToEvenHarmonicEnergyRatio").set(oddToEven->outputValue);
-        
-        tristimulus->algorithm->input("frequencies").set(harmonicPeaks->outputValues);
-        tristimulus->algorithm->input("magnitudes").set(harmonicPeaks->outputValues_2);
-        tristimulus->algorithm->output("tristimulus").set(tristimulus->outputValues);
+        harmonicDescriptors->setHarmonicPeaksInput(harmonicPeaks->outputValues, harmonicPeaks->outputValues_2);
         
         //MARK: TONAL
-        spectralPeaks_hpcp->algorithm->input("spectrum").set(spectrum->outputValues);
-        spectralPeaks_hpcp->algorithm->output("frequencies").set(spectralPeaks_hpcp->outputValues);
-        spectralPeaks_hpcp->algorithm->output("magnitudes").set(spectralPeaks_hpcp->outputValues_2);
+        spectralPeaks_hpcp->setPeaksInput(spectralPeaksSet);
         
         hpcp->algorithm->input("frequencies").set(spectralPeaks_hpcp->outputValues);
         hpcp->algorithm->input("magnitudes").set(spectralPeaks_hpcp->outputValues_2);
@@ -671,9 +809,12 @@ namespace ofxaa {
         hpcp_crest->algorithm->input("array").set(hpcp->outputValues);
         hpcp_crest->algorithm->output("crest").set(hpcp_crest->outputValue);
         
-        chordsDetection->algorithm->input("pcp").set(hpcp->realValuesAsVec());
-        chordsDetection->algorithm->output("chords").set(chordsDetection->stringValues);
-        chordsDetection->algorithm->output("strength").set(chordsDetection->outputValues);
+        chords->setHpcpInput(hpcp->outputValues);
+        key->setHpcpInput(hpcp->outputValues);
+        
+        //MARK: RHYTHM
+        tempo->setOnsetsInput(onsets);
+        beatTracker->setInputs(onsets, tempo);
         
     }
     //MARK: - COMPUTE
@@ -681,27 +822,61 @@ namespace ofxaa {
 
     void Network::computeAlgorithms(vector<Real>& signal, vector<Real>& accumulatedSignal){
         
-        _audioSignal = signal;
+        //Copied in place, the signal buffer lives in the arena.
+        std::copy(signal.begin(), signal.begin() + std::min(signal.size(), _audioSignal.size()), _audioSignal.begin());
         //_accumulatedAudioSignal = accumulatedSignal;
         
-//        for (auto algorithm : algorithms){
-        int size = algorithms.size();//70
+        bool isTiming = _isProfiling || _trace != NULL;
+        auto start = isTiming ? ProfileClock::now() : ProfileClock::time_point();
         for (int i=0; i<algorithms.size(); i++){
             if (algorithms[i]->getType() == TCToTotal || algorithms[i]->getType() == StrongDecay){
-                if(envelope->outputValues[0] != 0.0){
+                if(envelope->outputValues[0] == 0.0){
                     //StrongDecay and TcToTotal are not defined for a zero signal
-                    algorithms[i]->compute();
+                    if (_isProfiling){ _nodeProfiles[i].skip(); }
+                    continue;
                 }
+            }
+            int interval = algorithms[i]->updateInterval;
+            if (interval > 1 && _frameIndex % interval != 0){
+                //Outputs hold until the next update.
+                if (_isProfiling){ _nodeProfiles[i].skip(); }
+                continue;
+            }
+            if (!isTiming){
+                algorithms[i]->compute();
+            } else if (!algorithms[i]->isActive){
+                //Inactive nodes only clear their outputs.
+                algorithms[i]->compute();
+                if (_isProfiling){ _nodeProfiles[i].skip(); }
             } else {
-                
+                auto nodeStart = ProfileClock::now();
                 algorithms[i]->compute();
-                
+                auto nodeEnd = ProfileClock::now();
+                if (_isProfiling){
+                    _nodeProfiles[i].add(elapsedMicros(nodeStart, nodeEnd));
+                    _nodeProfiles[i].outputBytes = algorithms[i]->getOutputBytes();
+                }
+                if (_trace != NULL){
+                    _trace->record(_nodeProfiles[i].name.c_str(), nodeStart, nodeEnd);
+                }
             }
         }
+        if (isTiming){
+            auto end = ProfileClock::now();
+            if (_isProfiling){ _computeProfile.add(elapsedMicros(start, end)); }
+            if (_trace != NULL){ _trace->record(_computeProfile.name.c_str(), start, end); }
+        }
+        _frameIndex++;
         
     }
     
     //MARK: - GET VALUES
+    float Network::getBandEnergy(float startFrequency, float stopFrequency){
+        int startBin = energyIndex->getBinForFrequency(startFrequency);
+        int stopBin = energyIndex->getBinForFrequency(stopFrequency);
+        return energyIndex->getBandEnergy(startBin, stopBin);
+    }
+    
     float Network::getValue(ofxAAValue value, float smooth, bool normalized){
         switch (value) {
             
@@ -729,6 +904,17 @@ namespace ofxaa {
                 return pitchYinFFT->getValueAtIndex(0, smooth, normalized);
             case PITCH_YIN_CONFIDENCE:
                 return pitchYinFFT->getValueAtIndex(1, smooth, normalized);
+            
+            case CHORD_INDEX:
+                return chords->getValueAtIndex(0, smooth, normalized);
+            case CHORD_STRENGTH:
+                return chords->getValueAtIndex(1, smooth, normalized);
+            case KEY_INDEX:
+                return key->getValueAtIndex(0, smooth, normalized);
+            case KEY_MODE:
+                return key->getValueAtIndex(1, smooth, normalized);
+            case KEY_STRENGTH:
+                return key->getValueAtIndex(2, smooth, normalized);
            
             case DISTRIBUTION_SHAPE_KURTOSIS:
                 return distributionShape->getKurtosisValue(smooth, normalized);
@@ -767,6 +953,14 @@ namespace ofxaa {
                 
             case ONSETS:
                 return onsets->getValue();
+            case TEMPO_BPM:
+                return tempo->getValueAtIndex(0, smooth, normalized);
+            case TEMPO_CONFIDENCE:
+                return tempo->getValueAtIndex(1, smooth, normalized);
+            case BEAT_PULSE:
+                return beatTracker->getValueAtIndex(0, smooth, normalized);
+            case BEAT_PHASE:
+                return beatTracker->getValueAtIndex(1, smooth, normalized);
                 
             case NONE:
                 cout << "ofxAANetwork: getValue() for NONE value type" << endl;
@@ -846,6 +1040,16 @@ namespace ofxaa {
                 return pitchYinFFT;
             case PITCH_YIN_CONFIDENCE:
                 return pitchYinFFT;
+            case CHORD_INDEX:
+                return chords;
+            case CHORD_STRENGTH:
+                return chords;
+            case KEY_INDEX:
+                return key;
+            case KEY_MODE:
+                return key;
+            case KEY_STRENGTH:
+                return key;
                 //MARK: SPECTRAL
             case MEL_BANDS_KURTOSIS:
                 return melBands_distributionShape;
@@ -920,6 +1124,10 @@ namespace ofxaa {
                 return inharmonicity;
             case ODD_TO_EVEN:
                 return oddToEven;
+            case HARMONIC_SPECTRAL_TILT:
+                return harmonicSpectralTilt;
+            case HARMONIC_ENERGY:
+                return harmonicEnergy;
             case STRONG_PEAK:
                 return strongPeak;
                 
@@ -930,6 +1138,14 @@ namespace ofxaa {
                 
             case ONSETS:
                 return onsets;
+            case TEMPO_BPM:
+                return tempo;
+            case TEMPO_CONFIDENCE:
+                return tempo;
+            case BEAT_PULSE:
+                return beatTracker;
+            case BEAT_PHASE:
+                return beatTracker;
                 
             case NONE:
                 cout << "ofxAANetwork: getValue() for NONE value type" << endl;
@@ -944,9 +1160,13 @@ namespace ofxaa {
             case MFCC_MEL_BANDS:
                 return melBands;
             case GFCC_ERB_BANDS:
-                return gfcc;
+                return erbBands;
             case BARK_BANDS:
                 return barkBands;
+            case ENERGY_BANDS:
+                return energyBands;
+            case CONSTANT_Q:
+                return constantQ;
             case TRISTIMULUS:
                 return tristimulus;
             case HPCP:
@@ -1010,6 +1230,12 @@ namespace ofxaa {
                 return spectral_distributionShape->getMaxSkewnessValue();
             case PITCH_YIN_FREQUENCY:
                 return pitchYinFFT->getMaxEstimatedValues()[0];
+            case CHORD_INDEX:
+                return chords->getMaxEstimatedValues()[0];
+            case KEY_INDEX:
+                return key->getMaxEstimatedValues()[0];
+            case TEMPO_BPM:
+                return tempo->getMaxEstimatedValues()[0];
                 
             default:
                 return getAlgorithmWithType(valueType)->maxEstimatedValue;
@@ -1064,6 +1290,12 @@ namespace ofxaa {
                 return spectral_distributionShape->setMaxSkewnessValue(value);
             case PITCH_YIN_FREQUENCY:
                 return pitchYinFFT->setMaxEstimatedValues({value, 1.0});
+            case CHORD_INDEX:
+                return chords->setMaxEstimatedValues({value, 1.0});
+            case KEY_INDEX:
+                return key->setMaxEstimatedValues({value, 1.0, 1.0});
+            case TEMPO_BPM:
+                return tempo->setMaxEstimatedValues({value, 1.0});
                 
             default:
                 getAlgorithmWithType(valueType)->maxEstimatedValue = value;
@@ -26,9 +26,13 @@
 
 #include "ofxAudioAnalyzerAlgorithms.h"
 #include "ofxAAValues.h"
+#include "ofxAAProfiler.h"
+#include "ofxAATrace.h"
 
 
 #define ACCUMULATED_SIGNAL_MULTIPLIER 20
+#define NETWORK_FRAME_PERIOD_SMOOTHING 0.05
+#define NETWORK_MAX_FRAME_PERIOD 0.5 //seconds, longer hops are pauses of the host
 
 namespace ofxaa {
     class Network {
@@ -38,6 +42,18 @@ namespace ofxaa {
         
         void computeAlgorithms(vector<Real>& signal, vector<Real>& accumulatedSignal);
         
+        ///Returns the Network to the state it was built in: clears the algorithms state and restores
+        ///their settings, stops profiling, tracing and degradation. Nothing is allocated or planned.
+        void reset();
+        
+        int getSampleRate() const { return _samplerate; }
+        int getFrameSize() const { return _framesize; }
+        
+        ///Host time in seconds since the previous computeAlgorithms(), from the host timeline, set once per frame.
+        ///Averaged into the one frame period every time based node uses. Until set, bufferSize/sampleRate.
+        void setFramePeriod(Real seconds);
+        Real getFramePeriod() const { return _framePeriod; }
+        
         float getValue(ofxAAValue value, float smooth, bool normalized);
         float getValue(ofxAAValue value){ return getValue(value, 0.0, false); }
         
@@ -54,6 +70,33 @@ namespace ofxaa {
         void setMaxEstimatedValue(ofxAABinsValue valueType, float value);
         
         ofxAAOnsetsAlgorithm* getOnsetsPtr(){ return onsets;}
+        ofxAAEnergyBandsAlgorithm* getEnergyBandsPtr(){ return energyBands;}
+        ofxAAPitchYinFFTAlgorithm* getPitchYinFFTPtr(){ return pitchYinFFT;}
+        
+        size_t getArenaSize() const { return _arena.getSize(); }
+        
+        ///Energy between two frequencies (Hz) of the last analyzed frame, without an extra spectrum pass.
+        float getBandEnergy(float startFrequency, float stopFrequency);
+        
+        ///Times every node compute on a monotonic clock. Off by default, enabling it clears the profiles.
+        void setProfiling(bool enabled);
+        bool getProfiling(){ return _isProfiling; }
+        ///One profile per computed node, in compute order.
+        const vector<NodeProfile>& getNodeProfiles(){ return _nodeProfiles; }
+        const NodeProfile& getComputeProfile(){ return _computeProfile; }
+        
+        ///Records a span per node compute into trace. NULL stops tracing. The ring isn't owned.
+        void setTrace(TraceRing* trace){ _trace = trace; }
+        
+        //MARK: Degradation
+        ///Computes the tonal descriptors (pitch, peaks, harmonics, HPCP, constant-Q) one frame out of interval.
+        ///Chords and key keep computing every frame on the held HPCP.
+        void setTonalUpdateInterval(int interval);
+        ///Deactivates the band shape descriptors, spectral complexity and strong peak.
+        ///Restoring reactivates only what was active when they were dropped.
+        void setOptionalDescriptorsDropped(bool dropped);
+        ///Tonal descriptors computed on a half size frame where supported (pitch).
+        void setTonalFrameReduced(bool reduced);
         
         ofxAABaseAlgorithm* getAlgorithmWithType(ofxAAValue valueType);
         ofxAAOneVectorOutputAlgorithm* getAlgorithmWithType(ofxAABinsValue valueType);
@@ -61,20 +104,43 @@ namespace ofxaa {
     private:
         
         void createAlgorithms();
+        ///Adds a node to the compute list, name identifies it in the profiles.
+        void addAlgorithm(ofxAABaseAlgorithm* algorithm, const string& name);
         
+        void layoutBuffers();
         void connectAlgorithms();
         void deleteAlgorithms();
+        ///Groups the nodes the degradation setters act on.
+        void groupAlgorithms();
+        ///Hands the frame period to the time based nodes.
+        void applyFramePeriod();
         
         int _samplerate;
         int _framesize;
+        Real _framePeriod;
+        bool _hasHostFramePeriod;
         
-        vector<Real> _audioSignal;
+        ofxaa::Arena _arena;
+        
+        ofxaa::ArenaVector<Real> _audioSignalBuffer;
+        vector<Real>& _audioSignal = _audioSignalBuffer;
         //vector<Real> _accumulatedAudioSignal;
         
         vector<ofxAABaseAlgorithm*> algorithms;
         
+        bool _isProfiling;
+        vector<NodeProfile> _nodeProfiles;
+        NodeProfile _computeProfile;
+        TraceRing* _trace;
+        
+        unsigned long _frameIndex;
+        vector<ofxAABaseAlgorithm*> _tonalAlgorithms;
+        vector<ofxAABaseAlgorithm*> _optionalAlgorithms;
+        vector<bool> _optionalActiveStates;
+        bool _areOptionalDropped;
+        
         ofxAAOneVectorOutputAlgorithm* dcRemoval;
-        ofxAAOneVectorOutputAlgorithm* windowing;
+        ofxAAWindowingAlgorithm* windowing;
         
         ofxAAOneVectorOutputAlgorithm* equalLoudness;
         
@@ -97,46 +163,49 @@ namespace ofxaa {
         ofxAASingleOutputAlgorithm* maxToTotal;
         ofxAASingleOutputAlgorithm* tcToTotal;
         
-        ofxAAOneVectorOutputAlgorithm* spectrum;
-        ofxAANSGConstantQAlgorithm* nsgConstantQ;
+        ofxAAVectorComplexOutputAlgorithm* fft;
+        ofxAASpectrumAlgorithm* spectrum;
+        ofxAAEnergyIndexAlgorithm* energyIndex;
+        ofxAAConstantQAlgorithm* constantQ;
         //ofxAATwoVectorsOutputAlgorithm* mfcc;
         
-        ofxAAOneVectorOutputAlgorithm* melBands;
+        ofxAAFilterbankAlgorithm* melBands;
         ofxAAOneVectorOutputAlgorithm* melBands_centralMoments;
         ofxAADistributionShapeAlgorithm* melBands_distributionShape;
         ofxAASingleOutputAlgorithm* melBands_flatnessDb;
         ofxAASingleOutputAlgorithm* melBands_crest;
         
-        ofxAATwoVectorsOutputAlgorithm* gfcc;
+        ofxAAFilterbankAlgorithm* erbBands;
         ofxAAOneVectorOutputAlgorithm* erbBands_centralMoments;
         ofxAADistributionShapeAlgorithm* erbBands_distributionShape;
         ofxAASingleOutputAlgorithm* erbBands_flatnessDb;
         ofxAASingleOutputAlgorithm* erbBands_crest;
         
-        ofxAAOneVectorOutputAlgorithm* barkBands;
+        ofxAAFilterbankAlgorithm* barkBands;
         ofxAAOneVectorOutputAlgorithm* barkBands_centralMoments;
         ofxAADistributionShapeAlgorithm* barkBands_distributionShape;
         ofxAASingleOutputAlgorithm* barkBands_flatnessDb;
         ofxAASingleOutputAlgorithm* barkBands_crest;
         
-        ofxAAOneVectorOutputAlgorithm* unaryOperator_square;
         ofxAASingleOutputAlgorithm* spectral_decrease;
         
-        ofxAASingleOutputAlgorithm* rollOff;
-        ofxAASingleOutputAlgorithm* spectral_energy;
+        ofxAARollOffAlgorithm* rollOff;
+        ofxAAEnergyBandAlgorithm* spectral_energy;
         
-        ofxAASingleOutputAlgorithm* ebr_low;
-        ofxAASingleOutputAlgorithm* ebr_mid_low;
-        ofxAASingleOutputAlgorithm* ebr_mid_hi;
-        ofxAASingleOutputAlgorithm* ebr_hi;
+        ofxAAEnergyBandAlgorithm* ebr_low;
+        ofxAAEnergyBandAlgorithm* ebr_mid_low;
+        ofxAAEnergyBandAlgorithm* ebr_mid_hi;
+        ofxAAEnergyBandAlgorithm* ebr_hi;
+        ofxAAEnergyBandsAlgorithm* energyBands;
         
         ofxAASingleOutputAlgorithm* hfc;
         ofxAASingleOutputAlgorithm* spectral_flux;
         ofxAASingleOutputAlgorithm* strongPeak;
         ofxAASingleOutputAlgorithm* spectralComplexity;
         ofxAASingleOutputAlgorithm* pitchSalience;
-        ofxAATwoVectorsOutputAlgorithm* spectralPeaks;
-        ofxAASingleOutputAlgorithm* dissonance;
+        ofxAASpectralPeaksAlgorithm* spectralPeaksSet;
+        ofxAAPeaksViewAlgorithm* spectralPeaks;
+        ofxAADissonanceAlgorithm* dissonance;
         ofxAASingleOutputAlgorithm* spectral_entropy;
         ofxAASingleOutputAlgorithm* spectral_centroid;
         
@@ -146,23 +215,29 @@ namespace ofxaa {
         ofxAAOneVectorOutputAlgorithm* dynamicComplexity;
         
         ofxAATwoVectorsOutputAlgorithm* harmonicPeaks;
+        ofxAAHarmonicDescriptorsAlgorithm* harmonicDescriptors;
         ofxAASingleOutputAlgorithm* oddToEven;
         ofxAASingleOutputAlgorithm* inharmonicity;
         ofxAAOneVectorOutputAlgorithm* tristimulus;
+        ofxAASingleOutputAlgorithm* harmonicSpectralTilt;
+        ofxAASingleOutputAlgorithm* harmonicEnergy;
         
-        ofxAAOneVectorOutputAlgorithm* pitchYinFFT;
+        ofxAAPitchYinFFTAlgorithm* pitchYinFFT;
         ofxAATwoVectorsOutputAlgorithm* pitchMelodia;
         ofxAATwoVectorsOutputAlgorithm* predominantPitchMelodia;
         ofxAAVectorVectorOutputAlgorithm* multiPitchMelodia;
         ofxAAVectorVectorOutputAlgorithm* multiPitchKlapuri;
         
-        ofxAATwoVectorsOutputAlgorithm* spectralPeaks_hpcp;
+        ofxAAPeaksViewAlgorithm* spectralPeaks_hpcp;
         ofxAAOneVectorOutputAlgorithm* hpcp;
         ofxAASingleOutputAlgorithm* hpcp_entropy;
         ofxAASingleOutputAlgorithm* hpcp_crest;
-        ofxAATwoTypesVectorOutputAlgorithm* chordsDetection;
+        ofxAAChordsAlgorithm* chords;
+        ofxAAKeyAlgorithm* key;
         
         ofxAAOnsetsAlgorithm* onsets;
+        ofxAATempoAlgorithm* tempo;
+        ofxAABeatTrackerAlgorithm* beatTracker;
         
     };
 }
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+#include "ofxAANetworkPool.h"
+#include "ofxAANetwork.h"
+
+namespace ofxaa {
+    
+    NetworkPool& NetworkPool::instance(){
+        static NetworkPool pool;
+        return pool;
+    }
+    
+    Network* NetworkPool::acquire(int sampleRate, int frameSize){
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = _networks.find(Format(sampleRate, frameSize));
+            if (it != _networks.end() && !it->second.empty()){
+                Network* network = it->second.back();
+                it->second.pop_back();
+                return network;
+            }
+        }
+        return new Network(sampleRate, frameSize);
+    }
+    
+    void NetworkPool::release(Network* network){
+        if (network == NULL){ return; }
+        //Reset on the releasing thread, units are reclaimed off the cook thread.
+        network->reset();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto& networks = _networks[Format(network->getSampleRate(), network->getFrameSize())];
+            if (networks.size() < NETWORK_POOL_MAX_PER_FORMAT){
+                networks.push_back(network);
+                return;
+            }
+        }
+        delete network;
+    }
+    
+    void NetworkPool::clear(){
+        std::map<Format, std::vector<Network*>> networks;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            networks.swap(_networks);
+        }
+        for (auto& format : networks){
+            for (auto network : format.second){
+                delete network;
+            }
+        }
+    }
+    
+    int NetworkPool::getPooledNum(){
+        std::lock_guard<std::mutex> lock(_mutex);
+        int pooledNum = 0;
+        for (auto& format : _networks){
+            pooledNum += format.second.size();
+        }
+        return pooledNum;
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+///Networks kept per format. Beyond it released Networks are deleted.
+#define NETWORK_POOL_MAX_PER_FORMAT 16
+
+namespace ofxaa {
+    
+    class Network;
+    
+    ///Process wide cache of built Networks, keyed by format (samplerate, framesize).
+    ///Every Network builds the same algorithms, so the format is its whole configuration.
+    ///A released Network is reset and handed to the next acquire of its format:
+    ///reconfiguring to a format seen before costs a reset instead of a construction.
+    class NetworkPool {
+    public:
+        static NetworkPool& instance();
+        
+        ///Returns a Network for the format, from the pool or built. Thread safe.
+        Network* acquire(int sampleRate, int frameSize);
+        ///Resets network and keeps it for the next acquire of its format. Thread safe.
+        void release(Network* network);
+        ///Deletes every pooled Network. Called before Essentia is shut down.
+        void clear();
+        
+        int getPooledNum();
+        
+    private:
+        NetworkPool(){}
+        NetworkPool(const NetworkPool&) = delete;
+        NetworkPool& operator=(const NetworkPool&) = delete;
+        
+        typedef std::pair<int, int> Format;
+        
+        ///Never held while building or deleting a Network, those take the Runtime lock:
+        ///Runtime::release clears the pool with that lock held.
+        std::mutex _mutex;
+        std::map<Format, std::vector<Network*>> _networks;
+    };
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#pragma once
+
+#include <string>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+
+#define PROFILE_SMOOTHING 0.1
+///Log histogram: PROFILE_BUCKETS_PER_OCTAVE buckets per doubling from PROFILE_MIN_MICROS,
+///80 buckets reach ~100ms. Longer times land in the last bucket.
+#define PROFILE_MIN_MICROS 0.1
+#define PROFILE_BUCKETS_PER_OCTAVE 4
+#define PROFILE_BUCKETS_NUM 80
+
+namespace ofxaa {
+    
+    typedef std::chrono::steady_clock ProfileClock;
+    
+    inline double elapsedMicros(ProfileClock::time_point start, ProfileClock::time_point end){
+        return std::chrono::duration<double, std::micro>(end - start).count();
+    }
+    
+    ///Compute time of one Network node, recorded while the Network is profiling.
+    ///The histogram has fixed buckets, so recording and merging never allocate.
+    struct NodeProfile {
+        std::string name;
+        unsigned long calls = 0;
+        ///Frames the node was not computed: inactive, gated or between updates.
+        unsigned long skipped = 0;
+        double lastMicros = 0.0;
+        double smoothedMicros = 0.0;
+        double totalMicros = 0.0;
+        double maxMicros = 0.0;
+        size_t outputBytes = 0;
+        std::array<unsigned long, PROFILE_BUCKETS_NUM> histogram {};
+        
+        void add(double micros){
+            smoothedMicros = calls == 0 ? micros : smoothedMicros + PROFILE_SMOOTHING * (micros - smoothedMicros);
+            lastMicros = micros;
+            totalMicros += micros;
+            maxMicros = std::max(maxMicros, micros);
+            histogram[bucketForMicros(micros)]++;
+            calls++;
+        }
+        void skip(){ skipped++; }
+        
+        ///Adds the counts of other, as the same node of another channel.
+        void merge(const NodeProfile& other){
+            calls += other.calls;
+            skipped += other.skipped;
+            lastMicros += other.lastMicros;
+            smoothedMicros += other.smoothedMicros;
+            totalMicros += other.totalMicros;
+            maxMicros = std::max(maxMicros, other.maxMicros);
+            outputBytes += other.outputBytes;
+            for (int i=0; i<PROFILE_BUCKETS_NUM; i++){
+                histogram[i] += other.histogram[i];
+            }
+        }
+        
+        void reset(){
+            calls = 0;
+            skipped = 0;
+            lastMicros = 0.0;
+            smoothedMicros = 0.0;
+            totalMicros = 0.0;
+            maxMicros = 0.0;
+            histogram.fill(0);
+        }
+        
+        double getMeanMicros() const { return calls > 0 ? totalMicros / calls : 0.0; }
+        
+        ///Time below which the given fraction (0-1) of the calls fall.
+        ///Resolved to the bucket's geometric center, never above the max.
+        double getPercentileMicros(double fraction) const {
+            if (calls == 0){ return 0.0; }
+            unsigned long rank = (unsigned long)std::ceil(fraction * calls);
+            unsigned long count = 0;
+            for (int i=0; i<PROFILE_BUCKETS_NUM; i++){
+                count += histogram[i];
+                if (count >= rank && count > 0){
+                    double center = PROFILE_MIN_MICROS * std::exp2((i + 0.5) / PROFILE_BUCKETS_PER_OCTAVE);
+                    return std::min(center, maxMicros);
+                }
+            }
+            return maxMicros;
+        }
+        
+        static int bucketForMicros(double micros){
+            if (micros <= PROFILE_MIN_MICROS){ return 0; }
+            int bucket = (int)(std::log2(micros / PROFILE_MIN_MICROS) * PROFILE_BUCKETS_PER_OCTAVE);
+            return std::min(bucket, PROFILE_BUCKETS_NUM - 1);
+        }
+    };
+}
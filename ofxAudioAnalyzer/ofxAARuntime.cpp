@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#include "ofxAARuntime.h"
+#include "ofxAANetworkPool.h"
+
+#include "algorithmfactory.h"
+#include "fftw3.h"
+
+#include <cstdlib>
+#include <cstdio>
+#include <iostream>
+
+namespace ofxaa {
+    
+    namespace {
+        std::string defaultWisdomPath(){
+#ifdef _WIN32
+            const char* home = getenv("LOCALAPPDATA");
+            if (home == NULL){ home = getenv("USERPROFILE"); }
+#else
+            const char* home = getenv("HOME");
+#endif
+            if (home == NULL || home[0] == 0){ return ""; }
+            return std::string(home) + "/.ofxAudioAnalyzer-fftw3f.wisdom";
+        }
+        
+        std::string exportWisdom(){
+            char* wisdom = fftwf_export_wisdom_to_string();
+            if (wisdom == NULL){ return ""; }
+            std::string exported(wisdom);
+            free(wisdom);
+            return exported;
+        }
+    }
+    
+    Runtime& Runtime::instance(){
+        static Runtime runtime;
+        return runtime;
+    }
+    
+    Runtime::Runtime(){
+        _retainsNum = 0;
+        _isMeasuredPlanning = false;
+        _wisdomPath = defaultWisdomPath();
+    }
+    
+    void Runtime::retain(){
+        RuntimeLock lock(_mutex);
+        if (_retainsNum == 0 && !essentia::isInitialized()){
+            essentia::init();
+        }
+        if (_retainsNum == 0){
+            loadWisdom();
+        }
+        _retainsNum++;
+    }
+    
+    void Runtime::release(){
+        RuntimeLock lock(_mutex);
+        if (_retainsNum == 0){ return; }
+        _retainsNum--;
+        if (_retainsNum == 0){
+            //Pooled Networks hold Essentia algorithms.
+            NetworkPool::instance().clear();
+            saveWisdom();
+            essentia::standard::AlgorithmFactory::shutdown();
+            essentia::shutdown();
+        }
+    }
+    
+    int Runtime::getRetainsNum(){
+        RuntimeLock lock(_mutex);
+        return _retainsNum;
+    }
+    
+    void Runtime::setWisdomPath(const std::string& path){
+        RuntimeLock lock(_mutex);
+        _wisdomPath = path;
+    }
+    
+    std::string Runtime::getWisdomPath(){
+        RuntimeLock lock(_mutex);
+        return _wisdomPath;
+    }
+    
+    void Runtime::loadWisdom(){
+        if (_wisdomPath.empty()){ return; }
+        FILE* file = fopen(_wisdomPath.c_str(), "r");
+        if (file == NULL){ return; }
+        if (!fftwf_import_wisdom_from_file(file)){
+            std::cout << "ofxAudioAnalyzer: invalid FFTW wisdom file " << _wisdomPath << std::endl;
+        }
+        fclose(file);
+        _savedWisdom = exportWisdom();
+    }
+    
+    bool Runtime::saveWisdom(){
+        RuntimeLock lock(_mutex);
+        if (_wisdomPath.empty()){ return false; }
+        std::string wisdom = exportWisdom();
+        if (wisdom.empty() || wisdom == _savedWisdom){ return true; }
+        if (!fftwf_export_wisdom_to_filename(_wisdomPath.c_str())){
+            std::cout << "ofxAudioAnalyzer: could not write FFTW wisdom to " << _wisdomPath << std::endl;
+            return false;
+        }
+        _savedWisdom = wisdom;
+        return true;
+    }
+}
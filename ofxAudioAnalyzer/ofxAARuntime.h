@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <string>
+
+namespace ofxaa {
+    
+    ///Process wide Essentia state, shared by every analyzer in the process.
+    ///Essentia is initialized by the first retain and shut down by the last release,
+    ///so an analyzer exiting doesn't pull the factory from under the others.
+    ///The FFTW wisdom is loaded by the first retain and saved by the last release, so plans learned
+    ///in one session, measured ones above all, are made without planning in the next.
+    class Runtime {
+    public:
+        static Runtime& instance();
+        
+        void retain();
+        void release();
+        int getRetainsNum();
+        
+        ///FFTW wisdom file, defaults to a file in the user's home directory. Empty to not load nor save wisdom.
+        ///Set it before the first retain.
+        void setWisdomPath(const std::string& path);
+        std::string getWisdomPath();
+        ///Writes the FFTW wisdom to the wisdom file if it learned plans since it was loaded or saved.
+        bool saveWisdom();
+        
+        ///Plans the FFTs with FFTW_MEASURE instead of FFTW_ESTIMATE, for faster transforms.
+        ///Measuring a size takes a while once, later it comes from the wisdom.
+        ///Applies to the Networks built afterwards. Off by default.
+        void setMeasuredPlanning(bool measured){ _isMeasuredPlanning = measured; }
+        bool getMeasuredPlanning() const { return _isMeasuredPlanning; }
+        
+        ///Held while creating, configuring or deleting algorithms and while making or destroying FFTW plans:
+        ///neither the factory nor the FFTW planner are thread-safe. Recursive, so nested constructions can lock it again.
+        std::recursive_mutex& getMutex(){ return _mutex; }
+        
+    private:
+        Runtime();
+        Runtime(const Runtime&) = delete;
+        Runtime& operator=(const Runtime&) = delete;
+        
+        void loadWisdom();
+        
+        std::recursive_mutex _mutex;
+        int _retainsNum;
+        std::atomic<bool> _isMeasuredPlanning;
+        std::string _wisdomPath;
+        ///Wisdom as last loaded or saved.
+        std::string _savedWisdom;
+    };
+    
+    typedef std::lock_guard<std::recursive_mutex> RuntimeLock;
+}
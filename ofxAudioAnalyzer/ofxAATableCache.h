@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace ofxaa {
+    
+    ///Immutable tables shared by every Network of the process: windows, filterbanks, kernels, FFT plans, lookup tables.
+    ///One cache per kind of table, keyed by the parameters the table is built from.
+    ///Tables are refcounted: one lives while an algorithm holds it, and is built again by the next request after.
+    template <typename Table, typename Key>
+    class TableCache {
+    public:
+        ///Returns the table for key, made by build() if no one holds it.
+        ///build runs without the cache locked, so it can take the Runtime lock to plan FFTs.
+        template <typename Builder>
+        std::shared_ptr<const Table> get(const Key& key, Builder build){
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto it = _tables.find(key);
+                if (it != _tables.end()){
+                    if (auto table = it->second.lock()){ return table; }
+                }
+            }
+            
+            std::shared_ptr<const Table> table = build();
+            
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (auto it = _tables.begin(); it != _tables.end();){
+                if (it->second.expired()){
+                    it = _tables.erase(it);
+                } else {
+                    it++;
+                }
+            }
+            auto& entry = _tables[key];
+            //Built by another thread meanwhile: every holder gets the same copy.
+            if (auto existing = entry.lock()){ return existing; }
+            entry = table;
+            return table;
+        }
+        
+        int getTablesNum(){
+            std::lock_guard<std::mutex> lock(_mutex);
+            int tablesNum = 0;
+            for (auto& entry : _tables){
+                if (!entry.second.expired()){ tablesNum++; }
+            }
+            return tablesNum;
+        }
+        
+    private:
+        std::mutex _mutex;
+        std::map<Key, std::weak_ptr<const Table> > _tables;
+    };
+}
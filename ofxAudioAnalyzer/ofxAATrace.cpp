@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#include "ofxAATrace.h"
+
+#include <thread>
+#include <fstream>
+#include <cstring>
+#include <iostream>
+
+namespace ofxaa {
+    
+    static double clockMicros(ProfileClock::time_point time){
+        return std::chrono::duration<double, std::micro>(time.time_since_epoch()).count();
+    }
+    
+    static uint32_t currentThreadId(){
+        static thread_local uint32_t threadId = (uint32_t)std::hash<std::thread::id>()(std::this_thread::get_id());
+        return threadId;
+    }
+    
+    TraceRing::TraceRing(size_t eventsNum) : _events(new Event[eventsNum]), _eventsNum(eventsNum){
+        clear();
+    }
+    
+    void TraceRing::clear(){
+        for (size_t i=0; i<_eventsNum; i++){
+            _events[i].sequence.store(0, std::memory_order_relaxed);
+        }
+        _writeIndex.store(0, std::memory_order_release);
+    }
+    
+    void TraceRing::record(const char* name, ProfileClock::time_point begin, ProfileClock::time_point end){
+        uint64_t index = _writeIndex.fetch_add(1, std::memory_order_relaxed);
+        Event& event = _events[index % _eventsNum];
+        //Sequence 0 marks the slot as being written, readers skip it.
+        event.sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        
+        strncpy(event.name, name, TRACE_NAME_SIZE - 1);
+        event.name[TRACE_NAME_SIZE - 1] = '\0';
+        event.beginMicros = clockMicros(begin);
+        event.endMicros = clockMicros(end);
+        event.threadId = currentThreadId();
+        
+        event.sequence.store(index + 1, std::memory_order_release);
+    }
+    
+    bool TraceRing::writeJson(const std::string& path) const {
+        std::ofstream file(path);
+        if (!file.is_open()){
+            std::cout << "ofxAATrace: can't open trace file " << path << std::endl;
+            return false;
+        }
+        
+        uint64_t writeIndex = _writeIndex.load(std::memory_order_acquire);
+        uint64_t first = writeIndex > _eventsNum ? writeIndex - _eventsNum : 0;
+        
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool isFirst = true;
+        char line[256];
+        for (uint64_t index = first; index < writeIndex; index++){
+            const Event& event = _events[index % _eventsNum];
+            if (event.sequence.load(std::memory_order_acquire) != index + 1){ continue; }
+            Event copy;
+            memcpy(copy.name, event.name, TRACE_NAME_SIZE);
+            copy.beginMicros = event.beginMicros;
+            copy.endMicros = event.endMicros;
+            copy.threadId = event.threadId;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            //Overwritten while copying.
+            if (event.sequence.load(std::memory_order_relaxed) != index + 1){ continue; }
+            copy.name[TRACE_NAME_SIZE - 1] = '\0';
+            
+            snprintf(line, sizeof(line),
+                     "%s\n{\"name\":\"%s\",\"cat\":\"ofxaa\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                     isFirst ? "" : ",", copy.name, copy.beginMicros, copy.endMicros - copy.beginMicros, copy.threadId);
+            file << line;
+            isFirst = false;
+        }
+        file << "\n]}\n";
+        return file.good();
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <cstdint>
+
+#include "ofxAAProfiler.h"
+
+#define TRACE_EVENTS_NUM 65536
+#define TRACE_NAME_SIZE 32
+
+namespace ofxaa {
+    
+    ///Fixed ring of timed spans (begin and end of a cook or a node), written without locks
+    ///from any thread and dumped as Chrome Trace Event JSON (chrome://tracing, Perfetto).
+    ///When full the oldest spans are overwritten.
+    class TraceRing {
+    public:
+        TraceRing(size_t eventsNum = TRACE_EVENTS_NUM);
+        
+        TraceRing(const TraceRing&) = delete;
+        TraceRing& operator=(const TraceRing&) = delete;
+        
+        ///Records a span of the calling thread. Names longer than TRACE_NAME_SIZE are cut.
+        void record(const char* name, ProfileClock::time_point begin, ProfileClock::time_point end);
+        
+        void clear();
+        
+        ///Writes the recorded spans, oldest first. Spans being written meanwhile are left out.
+        bool writeJson(const std::string& path) const;
+        
+    private:
+        struct Event {
+            std::atomic<uint64_t> sequence;
+            char name[TRACE_NAME_SIZE];
+            double beginMicros;
+            double endMicros;
+            uint32_t threadId;
+        };
+        
+        std::unique_ptr<Event[]> _events;
+        size_t _eventsNum;
+        std::atomic<uint64_t> _writeIndex;
+    };
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#include "ofxAAWatchdog.h"
+
+#include <algorithm>
+#include <sstream>
+#include <iostream>
+
+namespace ofxaa {
+    
+    CookWatchdog::CookWatchdog(){
+        _budget = 0.0;
+        _steps = parseSteps("");
+        _level = 0;
+        _percentile = 0.0;
+        resetLevel();
+    }
+    
+    void CookWatchdog::resetLevel(){
+        _level = 0;
+        _windowsAtLevel = 0;
+        _restoreHold = 1;
+        _wasRestored = false;
+        clearWindow();
+    }
+    
+    void CookWatchdog::clearWindow(){
+        _costsNum = 0;
+        _costIndex = 0;
+    }
+    
+    void CookWatchdog::setBudget(double micros){
+        _budget = std::max(micros, 0.0);
+        if (_budget == 0.0){
+            resetLevel();
+        }
+        clearWindow();
+    }
+    
+    void CookWatchdog::setSteps(const std::vector<DegradationStep>& steps){
+        _steps = steps;
+        resetLevel();
+    }
+    
+    bool CookWatchdog::isStepApplied(DegradationStep step) const {
+        for (int i=0; i<_level; i++){
+            if (_steps[i] == step){ return true; }
+        }
+        return false;
+    }
+    
+    double CookWatchdog::computePercentile(){
+        std::copy(_costs.begin(), _costs.begin() + _costsNum, _sortedCosts.begin());
+        int rank = std::min(int(WATCHDOG_PERCENTILE * _costsNum), _costsNum - 1);
+        std::nth_element(_sortedCosts.begin(), _sortedCosts.begin() + rank, _sortedCosts.begin() + _costsNum);
+        return _sortedCosts[rank];
+    }
+    
+    bool CookWatchdog::addCost(double micros){
+        if (_budget == 0.0){ return false; }
+        
+        _costs[_costIndex] = micros;
+        _costIndex = (_costIndex + 1) % WATCHDOG_WINDOW_FRAMES;
+        _costsNum = std::min(_costsNum + 1, WATCHDOG_WINDOW_FRAMES);
+        //Decides once per full window, so each level is measured on its own cooks.
+        if (_costsNum < WATCHDOG_WINDOW_FRAMES || _costIndex != 0){ return false; }
+        
+        _percentile = computePercentile();
+        _windowsAtLevel++;
+        bool isOver = _percentile > _budget;
+        
+        if (isOver && _level < (int)_steps.size()){
+            if (_wasRestored && _windowsAtLevel == 1){
+                _restoreHold = std::min(_restoreHold * 2, WATCHDOG_MAX_RESTORE_HOLD);
+            }
+            _level++;
+            _wasRestored = false;
+        } else if (_percentile < _budget * WATCHDOG_RESTORE_RATIO && _level > 0 && _windowsAtLevel >= _restoreHold){
+            _level--;
+            _wasRestored = true;
+        } else {
+            //A restore that held for a window clears the back off.
+            if (_wasRestored && !isOver){
+                _wasRestored = false;
+                _restoreHold = 1;
+            }
+            return false;
+        }
+        _windowsAtLevel = 0;
+        clearWindow();
+        return true;
+    }
+    
+    std::vector<DegradationStep> CookWatchdog::parseSteps(const std::string& text){
+        std::vector<DegradationStep> steps;
+        std::string normalized = text;
+        std::replace(normalized.begin(), normalized.end(), ',', ' ');
+        std::istringstream stream(normalized);
+        std::string name;
+        while (stream >> name){
+            DegradationStep step;
+            if (name == "rate"){
+                step = TONAL_UPDATE_RATE;
+            } else if (name == "optional"){
+                step = OPTIONAL_DESCRIPTORS;
+            } else if (name == "frame"){
+                step = TONAL_FRAME_SIZE;
+            } else {
+                std::cout << "ofxAAWatchdog: unknown degradation step " << name << std::endl;
+                continue;
+            }
+            if (std::find(steps.begin(), steps.end(), step) == steps.end()){
+                steps.push_back(step);
+            }
+        }
+        if (steps.empty()){
+            steps = { TONAL_UPDATE_RATE, OPTIONAL_DESCRIPTORS, TONAL_FRAME_SIZE };
+        }
+        return steps;
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+
+#define WATCHDOG_WINDOW_FRAMES 128
+#define WATCHDOG_PERCENTILE 0.95
+///Restores a level only when the percentile is below this fraction of the budget.
+#define WATCHDOG_RESTORE_RATIO 0.7
+///A restore that goes over budget right away doubles the windows waited before the next one, up to this.
+#define WATCHDOG_MAX_RESTORE_HOLD 32
+#define WATCHDOG_TONAL_UPDATE_INTERVAL 4
+
+namespace ofxaa {
+    
+    ///Ways of shedding analysis work, applied one per degradation level in the configured order.
+    enum DegradationStep {
+        TONAL_UPDATE_RATE,
+        OPTIONAL_DESCRIPTORS,
+        TONAL_FRAME_SIZE
+    };
+    
+    ///Watches the cost of each cook against a budget in microseconds.
+    ///When the rolling percentile goes over budget one more step is applied, when there is enough
+    ///headroom the last step is restored. After every change a full window is measured before deciding again,
+    ///and restores that fail right away back off exponentially so levels don't flap.
+    class CookWatchdog {
+    public:
+        CookWatchdog();
+        
+        ///0 disables the watchdog and restores full quality.
+        void setBudget(double micros);
+        double getBudget() const { return _budget; }
+        
+        ///Steps in the order they are applied. Clears the level.
+        void setSteps(const std::vector<DegradationStep>& steps);
+        const std::vector<DegradationStep>& getSteps() const { return _steps; }
+        
+        ///Adds the cost of one cook. Returns true if the level changed.
+        bool addCost(double micros);
+        
+        ///0 is full quality, up to the number of steps.
+        int getLevel() const { return _level; }
+        bool isStepApplied(DegradationStep step) const;
+        double getPercentileMicros() const { return _percentile; }
+        
+        ///Parses step names separated by spaces or commas: "rate", "optional", "frame".
+        ///Unknown and repeated names are ignored. Empty text gives the default order.
+        static std::vector<DegradationStep> parseSteps(const std::string& text);
+        
+    private:
+        void clearWindow();
+        void resetLevel();
+        double computePercentile();
+        
+        double _budget;
+        std::vector<DegradationStep> _steps;
+        int _level;
+        double _percentile;
+        int _windowsAtLevel;
+        int _restoreHold;
+        bool _wasRestored;
+        
+        std::array<double, WATCHDOG_WINDOW_FRAMES> _costs;
+        std::array<double, WATCHDOG_WINDOW_FRAMES> _sortedCosts;
+        int _costsNum;
+        int _costIndex;
+    };
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+#include "ofxAAWindow.h"
+#include "ofxAATableCache.h"
+
+#include <tuple>
+#include <cmath>
+
+using essentia::Real;
+
+namespace ofxaa {
+    
+    void WindowTable::apply(const Real* frame, Real* windowed, bool zeroPhase) const {
+        const Real* w = values.data();
+        if (!zeroPhase){
+            for (int i=0; i<size; i++){ windowed[i] = frame[i] * w[i]; }
+            return;
+        }
+        int half = size / 2;
+        int j = 0;
+        for (int i=half; i<size; i++){ windowed[j++] = frame[i] * w[i]; }
+        for (int i=0; i<half; i++){ windowed[j++] = frame[i] * w[i]; }
+    }
+    
+    namespace {
+        
+        std::shared_ptr<const WindowTable> buildTable(WindowType type, int size, bool normalized){
+            auto table = std::make_shared<WindowTable>();
+            table->type = type;
+            table->size = size;
+            table->isNormalized = normalized;
+            table->values.resize(size);
+            
+            double a0 = type == HAMMING_WINDOW ? 0.54 : 0.5;
+            double denominator = size > 1 ? size - 1.0 : 1.0;
+            double sum = 0.0;
+            for (int i=0; i<size; i++){
+                table->values[i] = a0 - (1.0 - a0) * cos(2.0 * M_PI * i / denominator);
+                sum += table->values[i];
+            }
+            if (normalized && sum > 0.0){
+                Real scale = 2.0 / sum;
+                for (auto& value : table->values){ value *= scale; }
+            }
+            return table;
+        }
+    }
+    
+    std::shared_ptr<const WindowTable> getWindowTable(WindowType type, int size, bool normalized){
+        typedef std::tuple<int, int, bool> Key;
+        static TableCache<WindowTable, Key> tables;
+        
+        return tables.get(Key((int)type, size, normalized), [=](){
+            return buildTable(type, size, normalized);
+        });
+    }
+}
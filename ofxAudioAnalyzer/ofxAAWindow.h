@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2019 Leo Zimmerman [http://www.leozimmerman.com.ar]
+ *
+ * ofxAudioAnalyzer is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ *
+ * ---------------------------------------------------------------
+ *
+ * This project uses Essentia, copyrighted by Music Technology Group - Universitat Pompeu Fabra
+ * using GNU Affero General Public License.
+ * See http://essentia.upf.edu for documentation.
+ *
+ */
+
+#pragma once
+
+#include <vector>
+#include <memory>
+
+#include "types.h"
+
+namespace ofxaa {
+    
+    enum WindowType {
+        HANN_WINDOW,///0.5 - 0.5cos, symmetric (Essentia Windowing default)
+        HAMMING_WINDOW///0.54 - 0.46cos, symmetric
+    };
+    
+    ///Window function values, scaled so they sum 2 when normalized (as Essentia's Windowing).
+    struct WindowTable {
+        WindowType type;
+        int size;
+        bool isNormalized;
+        std::vector<essentia::Real> values;
+        
+        ///windowed = frame times the window, size values each. With zeroPhase the second half
+        ///of the windowed frame goes first, so the frame centre sits on sample 0.
+        void apply(const essentia::Real* frame, essentia::Real* windowed, bool zeroPhase) const;
+    };
+    
+    ///Returns the window for (type, size, normalized).
+    ///Windows are shared by every Network of the process while any of them holds one.
+    std::shared_ptr<const WindowTable> getWindowTable(WindowType type, int size, bool normalized);
+}
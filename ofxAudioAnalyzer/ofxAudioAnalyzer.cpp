@@ -27,59 +27,166 @@
 //-------------------------------------------------------
 void ofxAudioAnalyzer::setup(int sampleRate, int bufferSize, int channels){
     
-    if (sampleRate == _samplerate &&
+    if(channels <= 0){
+        cout << "ofxAudioAnalyzer: channels cant be set to none. Setting 1 channel" << endl;
+        channels = 1;
+    }
+    
+    collectBuild();
+    
+    _requestedSamplerate = sampleRate;
+    _requestedBuffersize = bufferSize;
+    _requestedChannels = channels;
+    
+    bool isCurrent = !channelAnalyzerUnits.empty() &&
+        sampleRate == _samplerate &&
         bufferSize == _buffersize &&
-        channels == _channels) {
+        channels == _channels;
+    if (isCurrent || _isBuilding) {
+        //A build for another format is checked against the request when it's collected.
         return;
     }
     
-    _samplerate = sampleRate;
-    _buffersize = bufferSize;
-    _channels = channels;
+    retainRuntime();
+    startBuild(sampleRate, bufferSize, channels);
+}
+//-------------------------------------------------------
+void ofxAudioAnalyzer::reset(int sampleRate, int bufferSize, int channels){
     
-    if(_channels <= 0){
+    if(channels <= 0){
         cout << "ofxAudioAnalyzer: channels cant be set to none. Setting 1 channel" << endl;
-        _channels = 1;
+        channels = 1;
     }
     
-    if (!essentia::isInitialized()){
-        essentia::init();
-    }
+    retainRuntime();
+    waitForBuild();
     
+    _samplerate = _requestedSamplerate = sampleRate;
+    _buffersize = _requestedBuffersize = bufferSize;
+    _channels = _requestedChannels = channels;
+    
+    deleteUnits();
     for(int i=0; i<_channels; i++){
         ofxAudioAnalyzerUnit * aaUnit = new ofxAudioAnalyzerUnit(_samplerate, _buffersize);
+        configureUnit(aaUnit, i);
         channelAnalyzerUnits.push_back(aaUnit);
     }
+    
+    loadStoredMaxEstimatedValues();
 }
 //-------------------------------------------------------
-void ofxAudioAnalyzer::reset(int sampleRate, int bufferSize, int channels){
-    
-    _samplerate = sampleRate;
-    _buffersize = bufferSize;
-    _channels = channels;
+void ofxAudioAnalyzer::startBuild(int sampleRate, int bufferSize, int channels){
+    _isBuilding = true;
+    _isBuildReady.store(false);
+    _builder = std::thread([this, sampleRate, bufferSize, channels](){
+        vector<ofxAudioAnalyzerUnit*> units;
+        for (int i=0; i<channels; i++){
+            units.push_back(new ofxAudioAnalyzerUnit(sampleRate, bufferSize));
+        }
+        _builtUnits = units;
+        _builtSamplerate = sampleRate;
+        _builtBuffersize = bufferSize;
+        _builtChannels = channels;
+        _isBuildReady.store(true, std::memory_order_release);
+    });
+}
+//-------------------------------------------------------
+void ofxAudioAnalyzer::collectBuild(){
+    if (!_isBuilding || !_isBuildReady.load(std::memory_order_acquire)){
+        return;
+    }
+    _builder.join();
+    _isBuilding = false;
     
-    if(_channels <= 0){
-        cout << "ofxAudioAnalyzer: channels cant be set to none. Setting 1 channel" << endl;
-        _channels = 1;
+    bool isRequested = _builtSamplerate == _requestedSamplerate &&
+        _builtBuffersize == _requestedBuffersize &&
+        _builtChannels == _requestedChannels;
+    if (!isRequested){
+        //The format changed again while building.
+        reclaimUnits(_builtUnits);
+        _builtUnits.clear();
+        bool isCurrent = !channelAnalyzerUnits.empty() &&
+            _requestedSamplerate == _samplerate &&
+            _requestedBuffersize == _buffersize &&
+            _requestedChannels == _channels;
+        if (!isCurrent){
+            startBuild(_requestedSamplerate, _requestedBuffersize, _requestedChannels);
+        }
+        return;
     }
     
-    for (int i=0; i<channelAnalyzerUnits.size(); i++){
-        channelAnalyzerUnits[i]->exit();
+    for (int i=0; i<(int)_builtUnits.size(); i++){
+        configureUnit(_builtUnits[i], i);
     }
-    channelAnalyzerUnits.clear();
+    channelAnalyzerUnits.swap(_builtUnits);
+    _samplerate = _builtSamplerate;
+    _buffersize = _builtBuffersize;
+    _channels = _builtChannels;
+    loadStoredMaxEstimatedValues();
     
-    for(int i=0; i<_channels; i++){
-        ofxAudioAnalyzerUnit * aaUnit = new ofxAudioAnalyzerUnit(_samplerate, _buffersize);
-        channelAnalyzerUnits.push_back(aaUnit);
+    reclaimUnits(_builtUnits);
+    _builtUnits.clear();
+}
+//-------------------------------------------------------
+void ofxAudioAnalyzer::waitForBuild(){
+    if (!_isBuilding){ return; }
+    _builder.join();
+    _isBuilding = false;
+    for (auto unit : _builtUnits){
+        delete unit;
     }
+    _builtUnits.clear();
+}
+//-------------------------------------------------------
+void ofxAudioAnalyzer::reclaimUnits(const vector<ofxAudioAnalyzerUnit*>& units){
+    if (units.empty()){ return; }
+    //The previous reclaim finished long ago, unless formats change every cook.
+    if (_reclaimer.joinable()){
+        _reclaimer.join();
+    }
+    _reclaimer = std::thread([units](){
+        for (auto unit : units){
+            delete unit;
+        }
+    });
+}
+//-------------------------------------------------------
+void ofxAudioAnalyzer::configureUnit(ofxAudioAnalyzerUnit* unit, int channel){
+    unit->setProfiling(_isProfiling);
+    unit->setTrace(_isTracing ? _trace.get() : NULL);
+    applyDegradation(unit);
     
-    loadStoredMaxEstimatedValues();
+    auto it = storedChannelSettings.find(channel);
+    if (it == storedChannelSettings.end()){ return; }
+    const ChannelSettings& settings = it->second;
+    if (!settings.bandEdges.empty()){
+        unit->getEnergyBandsPtr()->setBandEdges(settings.bandEdges);
+    } else if (settings.bandsPerOctave > 0){
+        unit->getEnergyBandsPtr()->setBandsPerOctave(settings.bandsPerOctave);
+    }
+    auto pitchYinFFT = unit->getPitchYinFFTPtr();
+    if (settings.hasPitchRange){
+        pitchYinFFT->setFrequencyRange(settings.minPitchFrequency, settings.maxPitchFrequency);
+    }
+    pitchYinFFT->setTrackingEnabled(settings.isPitchTracking);
+    if (settings.hasOnsetsParameters){
+        auto onsets = unit->getOnsetsPtr();
+        onsets->setOnsetAlpha(settings.onsetsAlpha);
+        onsets->setOnsetSilenceThreshold(settings.onsetsSilenceThreshold);
+        onsets->setOnsetTimeThreshold(settings.onsetsTimeThreshold);
+        onsets->setUseTimeThreshold(settings.onsetsUseTimeThreshold);
+    }
 }
 //-------------------------------------------------------
 void ofxAudioAnalyzer::analyze(const OP_CHOPInput& cInput){
-   
-    if(cInput.numChannels != _channels){
-        cout <<"ofxAudioAnalyzer: inBuffer channels number incorrect." << endl;
+    
+    collectBuild();
+    
+    if(cInput.numChannels != _channels || cInput.numSamples != _buffersize){
+        //Values hold while the units for the new format are built.
+        if (!_isBuilding){
+            cout <<"ofxAudioAnalyzer: inBuffer channels number or size incorrect." << endl;
+        }
         return;
     }
     
@@ -88,6 +195,8 @@ void ofxAudioAnalyzer::analyze(const OP_CHOPInput& cInput){
         return;
     }
     
+    bool isTiming = _isTracing || _watchdog.getBudget() > 0.0;
+    auto start = isTiming ? ofxaa::ProfileClock::now() : ofxaa::ProfileClock::time_point();
     
     for (int i=0; i<_channels; i++){
         const float * channelPtr = cInput.getChannelData(i);
@@ -97,24 +206,56 @@ void ofxAudioAnalyzer::analyze(const OP_CHOPInput& cInput){
             bufferCopy.push_back(channelPtr[i]);
         }
         if(channelAnalyzerUnits[i]!=nullptr){
+            if (_framePeriod > 0.0){
+                channelAnalyzerUnits[i]->setFramePeriod(_framePeriod);
+            }
             channelAnalyzerUnits[i]->analyze(bufferCopy);
         }else{
             cout << "ofxAudioAnalyzer: channelAnalyzer NULL pointer" << endl;
         }
     }
+    
+    if (isTiming){
+        auto end = ofxaa::ProfileClock::now();
+        if (_isTracing){
+            _trace->record("analyze", start, end);
+        }
+        if (_watchdog.addCost(ofxaa::elapsedMicros(start, end))){
+            for (auto unit : channelAnalyzerUnits){
+                applyDegradation(unit);
+            }
+        }
+    }
 }
 //-------------------------------------------------------
 void ofxAudioAnalyzer::exit(){
-    AlgorithmFactory& factory = AlgorithmFactory::instance();
-    factory.shutdown();
-    
-    essentia::shutdown();
+    waitForBuild();
+    if (_reclaimer.joinable()){
+        _reclaimer.join();
+    }
+    deleteUnits();
     
-    for(int i=0; i<channelAnalyzerUnits.size();i++){
-        channelAnalyzerUnits[i]->exit();
+    //Essentia stays up while other analyzers use it.
+    if (_isRuntimeRetained){
+        ofxaa::Runtime::instance().release();
+        _isRuntimeRetained = false;
     }
 }
 //-------------------------------------------------------
+void ofxAudioAnalyzer::retainRuntime(){
+    if (!_isRuntimeRetained){
+        ofxaa::Runtime::instance().retain();
+        _isRuntimeRetained = true;
+    }
+}
+//-------------------------------------------------------
+void ofxAudioAnalyzer::deleteUnits(){
+    for (auto unit : channelAnalyzerUnits){
+        delete unit;
+    }
+    channelAnalyzerUnits.clear();
+}
+//-------------------------------------------------------
 float ofxAudioAnalyzer::getValue(ofxAAValue valueType, int channel, float smooth, bool normalized) const {
     if (channel >= _channels){
         cout << "ofxAudioAnalyzer: channel for getting value is incorrect." << endl;
@@ -149,6 +290,14 @@ vector<float>& ofxAudioAnalyzer::getValues(ofxAABinsValue valueType, int channel
     
 }
 //-------------------------------------------------------
+float ofxAudioAnalyzer::getBandEnergy(int channel, float startFrequency, float stopFrequency) const {
+    if (channel >= _channels){
+        cout << "ofxAudioAnalyzer: channel for getting value is incorrect." << endl;
+        return 0.0;
+    }
+    return channelAnalyzerUnits[channel]->getBandEnergy(startFrequency, stopFrequency);
+}
+//-------------------------------------------------------
 bool ofxAudioAnalyzer::getOnsetValue(int channel) const {
     
     if (channel >= _channels){
@@ -192,6 +341,13 @@ void ofxAudioAnalyzer::setMaxEstimatedValue(int channel, ofxAABinsValue valueTyp
 //-------------------------------------------------------
 void ofxAudioAnalyzer::setOnsetsParameters(int channel, float alpha, float silenceTresh, float timeTresh, bool useTimeTresh){
     
+    ChannelSettings& settings = storedChannelSettings[channel];
+    settings.hasOnsetsParameters = true;
+    settings.onsetsAlpha = alpha;
+    settings.onsetsSilenceThreshold = silenceTresh;
+    settings.onsetsTimeThreshold = timeTresh;
+    settings.onsetsUseTimeThreshold = useTimeTresh;
+    
     if (channel >= _channels){
         cout << "ofxAudioAnalyzer: channel for getting value is incorrect." << endl;
         return;
@@ -211,23 +367,118 @@ void ofxAudioAnalyzer::loadStoredMaxEstimatedValues() {
         }
     }
 }
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
+//-------------------------------------------------------
+void ofxAudioAnalyzer::setEnergyBandsEdges(int channel, const vector<float>& edges){
+    ChannelSettings& settings = storedChannelSettings[channel];
+    settings.bandEdges = edges;
+    settings.bandsPerOctave = 0;
+    if (channel >= _channels){
+        cout << "ofxAudioAnalyzer: channel for setting energy bands is incorrect." << endl;
+        return;
+    }
+    channelAnalyzerUnits[channel]->getEnergyBandsPtr()->setBandEdges(edges);
+}
+//-------------------------------------------------------
+void ofxAudioAnalyzer::setEnergyBandsPerOctave(int channel, int bandsPerOctave){
+    ChannelSettings& settings = storedChannelSettings[channel];
+    settings.bandEdges.clear();
+    settings.bandsPerOctave = bandsPerOctave;
+    if (channel >= _channels){
+        cout << "ofxAudioAnalyzer: channel for setting energy bands is incorrect." << endl;
+        return;
+    }
+    channelAnalyzerUnits[channel]->getEnergyBandsPtr()->setBandsPerOctave(bandsPerOctave);
+}
+//-------------------------------------------------------
+void ofxAudioAnalyzer::setPitchFrequencyRange(int channel, float minFrequency, float maxFrequency){
+    ChannelSettings& settings = storedChannelSettings[channel];
+    settings.hasPitchRange = true;
+    settings.minPitchFrequency = minFrequency;
+    settings.maxPitchFrequency = maxFrequency;
+    if (channel >= _channels){
+        cout << "ofxAudioAnalyzer: channel for setting pitch range is incorrect." << endl;
+        return;
+    }
+    channelAnalyzerUnits[channel]->getPitchYinFFTPtr()->setFrequencyRange(minFrequency, maxFrequency);
+}
+//-------------------------------------------------------
+void ofxAudioAnalyzer::setProfiling(bool enabled){
+    if (enabled == _isProfiling){ return; }
+    _isProfiling = enabled;
+    for (auto unit : channelAnalyzerUnits){
+        unit->setProfiling(enabled);
+    }
+}
+//-------------------------------------------------------
+const vector<ofxaa::NodeProfile>& ofxAudioAnalyzer::getNodeProfiles(int channel){
+    if (channel >= _channels){
+        cout << "ofxAudioAnalyzer: channel for getting profiles is incorrect." << endl;
+        channel = 0;
+    }
+    return channelAnalyzerUnits[channel]->getNodeProfiles();
+}
+//-------------------------------------------------------
+const ofxaa::NodeProfile& ofxAudioAnalyzer::getComputeProfile(int channel){
+    if (channel >= _channels){
+        cout << "ofxAudioAnalyzer: channel for getting profiles is incorrect." << endl;
+        channel = 0;
+    }
+    return channelAnalyzerUnits[channel]->getComputeProfile();
+}
+//-------------------------------------------------------
+void ofxAudioAnalyzer::setTracing(bool enabled){
+    if (enabled == _isTracing){ return; }
+    if (enabled){
+        if (!_trace){
+            _trace.reset(new ofxaa::TraceRing());
+        }
+        _trace->clear();
+    }
+    _isTracing = enabled;
+    for (auto unit : channelAnalyzerUnits){
+        unit->setTrace(_isTracing ? _trace.get() : NULL);
+    }
+}
+//-------------------------------------------------------
+bool ofxAudioAnalyzer::writeTrace(const string& path){
+    if (!_trace){
+        cout << "ofxAudioAnalyzer: nothing traced, enable tracing first." << endl;
+        return false;
+    }
+    return _trace->writeJson(path);
+}
+//-------------------------------------------------------
+void ofxAudioAnalyzer::setCookBudget(double micros){
+    if (micros == _watchdog.getBudget()){ return; }
+    _watchdog.setBudget(micros);
+    for (auto unit : channelAnalyzerUnits){
+        applyDegradation(unit);
+    }
+}
+//-------------------------------------------------------
+void ofxAudioAnalyzer::setDegradationSteps(const vector<ofxaa::DegradationStep>& steps){
+    if (steps == _watchdog.getSteps()){ return; }
+    _watchdog.setSteps(steps);
+    for (auto unit : channelAnalyzerUnits){
+        applyDegradation(unit);
+    }
+}
+//-------------------------------------------------------
+void ofxAudioAnalyzer::applyDegradation(ofxAudioAnalyzerUnit* unit){
+    bool isRateLowered = _watchdog.isStepApplied(ofxaa::TONAL_UPDATE_RATE);
+    unit->setTonalUpdateInterval(isRateLowered ? WATCHDOG_TONAL_UPDATE_INTERVAL : 1);
+    unit->setOptionalDescriptorsDropped(_watchdog.isStepApplied(ofxaa::OPTIONAL_DESCRIPTORS));
+    unit->setTonalFrameReduced(_watchdog.isStepApplied(ofxaa::TONAL_FRAME_SIZE));
+}
+//-------------------------------------------------------
+void ofxAudioAnalyzer::setPitchTracking(int channel, bool enabled){
+    storedChannelSettings[channel].isPitchTracking = enabled;
+    if (channel >= _channels){
+        cout << "ofxAudioAnalyzer: channel for setting pitch tracking is incorrect." << endl;
+        return;
+    }
+    auto pitchYinFFT = channelAnalyzerUnits[channel]->getPitchYinFFTPtr();
+    if (pitchYinFFT->getTrackingEnabled() != enabled){
+        pitchYinFFT->setTrackingEnabled(enabled);
+    }
+}
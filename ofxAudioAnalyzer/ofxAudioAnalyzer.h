@@ -25,16 +25,31 @@
 #pragma once
 
 //
+#include <thread>
+#include <atomic>
+
 #include "ofxAudioAnalyzerUnit.h"
+#include "ofxAAWatchdog.h"
+#include "ofxAARuntime.h"
 #include "CHOP_CPlusPlusBase.h"
 
 class ofxAudioAnalyzer{
  
  public:
     
+    ~ofxAudioAnalyzer(){ exit(); }
+    
+    ///Builds the units for a new format on a background thread. Until they are swapped in,
+    ///at a later setup() or analyze(), values hold from the previous format. The old units are deleted off thread.
     void setup(int sampleRate, int bufferSize, int channels);
+    ///Rebuilds the units right away, on the calling thread.
     void reset(int sampleRate, int bufferSize, int channels);
     void analyze(const OP_CHOPInput& cInput);
+    
+    ///Host time in seconds between analyze() calls, from the host timeline rather than a clock,
+    ///so tempo, beats, chords and key follow the timeline in realtime and non realtime cooks.
+    ///Set it before each analyze(). 0 (default) assumes bufferSize/sampleRate.
+    void setFramePeriod(double seconds){ _framePeriod = seconds; }
     void exit();
     
     int getSampleRate() const {return _samplerate;}
@@ -54,6 +69,12 @@ class ofxAudioAnalyzer{
     ///\param smooth: smoothing amount. 0.0=non smoothing, 1.0=fixed value
     vector<float>& getValues(ofxAABinsValue valueType, int channel, float smooth, bool normalized);
     
+    ///Gets the spectral energy between two frequencies.
+    ///Any number of bands can be queried per frame, each costs two lookups.
+    ///\param channel: starting from 0 (for stereo setup, 0 and 1)
+    ///\param startFrequency, stopFrequency: band limits in Hz
+    float getBandEnergy(int channel, float startFrequency, float stopFrequency) const;
+    
     ///Returns if there is an onset in the speciefied channel.
     bool getOnsetValue(int channel) const;
     
@@ -76,19 +97,110 @@ class ofxAudioAnalyzer{
     ///\param useTimeThreshold: use or note the time threshold.
     void setOnsetsParameters(int channel, float alpha, float silenceTresh, float timeTresh, bool useTimeTresh = true);
     
+    ///Sets the bands of the ENERGY_BANDS value.
+    ///\param channel: starting from 0 (for stereo setup, 0 and 1)
+    ///\param edges: ascending band edges in Hz, N+1 edges make N bands.
+    void setEnergyBandsEdges(int channel, const vector<float>& edges);
+    ///\param bandsPerOctave: 1 for octave bands, 3 for third octave bands.
+    void setEnergyBandsPerOctave(int channel, int bandsPerOctave);
+    
+    ///Sets the search range of the PITCH_YIN_FREQUENCY value.
+    ///\param minFrequency, maxFrequency: in Hz.
+    void setPitchFrequencyRange(int channel, float minFrequency, float maxFrequency);
+    ///Searches PITCH_YIN_FREQUENCY around the previous pitch while it stays confident.
+    void setPitchTracking(int channel, bool enabled);
+    
+    ///Times every algorithm of every channel. Off by default.
+    void setProfiling(bool enabled);
+    bool getProfiling() const {return _isProfiling;}
+    ///Per algorithm compute times of a channel, in compute order. Empty profiles while not profiling.
+    const vector<ofxaa::NodeProfile>& getNodeProfiles(int channel);
+    ///Compute time of all the algorithms of a channel.
+    const ofxaa::NodeProfile& getComputeProfile(int channel);
+    
+    ///Records each analyze() and node compute into a preallocated ring. Off by default.
+    ///The ring is allocated the first time tracing is enabled and cleared on every enable.
+    void setTracing(bool enabled);
+    bool getTracing() const {return _isTracing;}
+    ///Writes the recorded spans as Chrome Trace Event JSON. Returns false if nothing could be written.
+    bool writeTrace(const string& path);
+    
+    ///Max cost of analyze() in microseconds, 0 (default) for no budget.
+    ///Over budget the analysis sheds work one degradation step at a time, and restores it with headroom.
+    void setCookBudget(double micros);
+    double getCookBudget() const {return _watchdog.getBudget();}
+    ///Order in which the degradation steps are applied. Restores full quality.
+    void setDegradationSteps(const vector<ofxaa::DegradationStep>& steps);
+    ///Number of degradation steps applied, 0 is full quality.
+    int getDegradationLevel() const {return _watchdog.getLevel();}
+    ///Rolling percentile cost of analyze() the last level change was decided on.
+    double getCookPercentile() const {return _watchdog.getPercentileMicros();}
+    
 
  private:
     
     void loadStoredMaxEstimatedValues();
-    
-    int _samplerate;
-    int _buffersize;
-    int _channels;
+    ///Each analyzer holds one reference to the Essentia runtime, from setup to exit.
+    void retainRuntime();
+    void deleteUnits();
+    void startBuild(int sampleRate, int bufferSize, int channels);
+    ///Swaps in the built units if they are ready and still requested.
+    void collectBuild();
+    ///Joins a build in progress and drops its units.
+    void waitForBuild();
+    ///Deletes units on a background thread.
+    void reclaimUnits(const vector<ofxAudioAnalyzerUnit*>& units);
+    ///Applies the analyzer settings and the stored settings of its channel to a new unit.
+    void configureUnit(ofxAudioAnalyzerUnit* unit, int channel);
+    ///Applies the watchdog level to a unit.
+    void applyDegradation(ofxAudioAnalyzerUnit* unit);
+    
+    int _samplerate = 0;
+    int _buffersize = 0;
+    int _channels = 0;
+    double _framePeriod = 0.0;
+    
+    bool _isRuntimeRetained = false;
+    bool _isProfiling = false;
+    bool _isTracing = false;
+    unique_ptr<ofxaa::TraceRing> _trace;
+    ofxaa::CookWatchdog _watchdog;
     
     map<ofxAAValue, float> storedMaxEstimatedValues;
     
+    ///Per channel settings, reapplied to the units built for a new format.
+    struct ChannelSettings {
+        vector<float> bandEdges;///empty when set per octave
+        int bandsPerOctave = 0;///0 when not set
+        bool hasPitchRange = false;
+        float minPitchFrequency = 0.0;
+        float maxPitchFrequency = 0.0;
+        bool isPitchTracking = false;
+        bool hasOnsetsParameters = false;
+        float onsetsAlpha = 0.0;
+        float onsetsSilenceThreshold = 0.0;
+        float onsetsTimeThreshold = 0.0;
+        bool onsetsUseTimeThreshold = true;
+    };
+    map<int, ChannelSettings> storedChannelSettings;
+    
     vector<ofxAudioAnalyzerUnit*> channelAnalyzerUnits;
     
+    int _requestedSamplerate = 0;
+    int _requestedBuffersize = 0;
+    int _requestedChannels = 0;
+    
+    bool _isBuilding = false;
+    std::atomic<bool> _isBuildReady {false};
+    std::thread _builder;
+    ///Written by the builder thread before _isBuildReady is set.
+    vector<ofxAudioAnalyzerUnit*> _builtUnits;
+    int _builtSamplerate = 0;
+    int _builtBuffersize = 0;
+    int _builtChannels = 0;
+    
+    std::thread _reclaimer;
+    
     
 };
 
@@ -32,4 +32,21 @@
 #include "ofxAAOnsetsAlgorithm.h"
 #include "ofxAANSGConstantQAlgorithm.h"
 #include "ofxAADistributionShapeAlgorithm.h"
+#include "ofxAASpectrumAlgorithm.h"
+#include "ofxAAEnergyIndexAlgorithm.h"
+#include "ofxAAEnergyBandAlgorithm.h"
+#include "ofxAAEnergyBandsAlgorithm.h"
+#include "ofxAARollOffAlgorithm.h"
+#include "ofxAAFilterbankAlgorithm.h"
+#include "ofxAASpectralPeaksAlgorithm.h"
+#include "ofxAAPeaksViewAlgorithm.h"
+#include "ofxAAHarmonicDescriptorsAlgorithm.h"
+#include "ofxAADissonanceAlgorithm.h"
+#include "ofxAAPitchYinFFTAlgorithm.h"
+#include "ofxAAConstantQAlgorithm.h"
+#include "ofxAAChordsAlgorithm.h"
+#include "ofxAAKeyAlgorithm.h"
+#include "ofxAATempoAlgorithm.h"
+#include "ofxAABeatTrackerAlgorithm.h"
+#include "ofxAAWindowingAlgorithm.h"
 
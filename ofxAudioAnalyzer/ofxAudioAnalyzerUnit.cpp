@@ -34,7 +34,7 @@ ofxAudioAnalyzerUnit::ofxAudioAnalyzerUnit(int sampleRate, int bufferSize) {
     audioBuffer.resize(bufferSize);
     accumulatedAudioBuffer.resize(bufferSize * ACCUMULATED_SIGNAL_MULTIPLIER, 0.0);
     
-    network = new ofxaa::Network(samplerate, framesize);
+    network = ofxaa::NetworkPool::instance().acquire(samplerate, framesize);
 }
 //--------------------------------------------------------------
 void ofxAudioAnalyzerUnit::analyze(const vector<float> & inBuffer){
@@ -56,7 +56,8 @@ void ofxAudioAnalyzerUnit::analyze(const vector<float> & inBuffer){
 
 //--------------------------------------------------------------
 void ofxAudioAnalyzerUnit::exit(){
-    delete network;
+    ofxaa::NetworkPool::instance().release(network);
+    network = NULL;
 }
 
 //--------------------------------------------------------------
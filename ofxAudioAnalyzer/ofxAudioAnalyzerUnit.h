@@ -26,6 +26,7 @@
 
 #include "ofxAudioAnalyzerAlgorithms.h"
 #include "ofxAANetwork.h"
+#include "ofxAANetworkPool.h"
 
 class ofxAudioAnalyzerUnit
 {
@@ -48,6 +49,7 @@ public:
     float getValue(ofxAAValue value){ return getValue(value, 0.0, false); }
     vector<float>& getValues(ofxAABinsValue value, float smooth , bool normalized);
     vector<float>& getValues(ofxAABinsValue value){ return getValues(value, 0.0, false); }
+    float getBandEnergy(float startFrequency, float stopFrequency){ return network->getBandEnergy(startFrequency, stopFrequency); }
     
     void setActive(ofxAAValue valueType, bool state);
     void setActive(ofxAABinsValue valueType, bool state);
@@ -65,6 +67,16 @@ public:
     void setMaxEstimatedValue(ofxAABinsValue valueType, float value);
     
     ofxAAOnsetsAlgorithm* getOnsetsPtr(){ return network->getOnsetsPtr();}
+    ofxAAEnergyBandsAlgorithm* getEnergyBandsPtr(){ return network->getEnergyBandsPtr();}
+    ofxAAPitchYinFFTAlgorithm* getPitchYinFFTPtr(){ return network->getPitchYinFFTPtr();}
+    void setProfiling(bool enabled){ network->setProfiling(enabled); }
+    const vector<ofxaa::NodeProfile>& getNodeProfiles(){ return network->getNodeProfiles(); }
+    const ofxaa::NodeProfile& getComputeProfile(){ return network->getComputeProfile(); }
+    void setTrace(ofxaa::TraceRing* trace){ network->setTrace(trace); }
+    void setTonalUpdateInterval(int interval){ network->setTonalUpdateInterval(interval); }
+    void setOptionalDescriptorsDropped(bool dropped){ network->setOptionalDescriptorsDropped(dropped); }
+    void setTonalFrameReduced(bool reduced){ network->setTonalFrameReduced(reduced); }
+    void setFramePeriod(Real seconds){ network->setFramePeriod(seconds); }
     ofxAABaseAlgorithm* getAlgorithmWithType(ofxAAValue valueType){ return network->getAlgorithmWithType(valueType); };
     ofxAAOneVectorOutputAlgorithm* getAlgorithmWithType(ofxAABinsValue valueType) { return network->getAlgorithmWithType(valueType); };
     